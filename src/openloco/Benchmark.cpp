@@ -0,0 +1,51 @@
+#include "Benchmark.h"
+#include "console.h"
+#include "graphics/gfx.h"
+#include "map/tilemgr.h"
+#include "things/vehicle.h"
+
+namespace openloco::benchmark
+{
+    struct Suite
+    {
+        const char* name;
+        bool (*run)();
+    };
+
+    // Each suite checks native routines against the loco routines or the implementations they replaced,
+    // and times both. Suites return false when any of the results differ.
+    static constexpr Suite _suites[] = {
+        { "images", gfx::benchmark_images },
+        { "text_runs", gfx::benchmark_text_runs },
+        { "sprite_angles", things::vehicle::benchmarkSpriteAngles },
+        { "slope_heights", map::tilemgr::benchmark_slope_heights },
+    };
+
+    void report(const char* name, uint32_t iterations, clock::duration time)
+    {
+        using ns = std::chrono::duration<double, std::nano>;
+        console::log("  %-40s %12.1f ns", name, ns(time).count() / iterations);
+    }
+
+    // Runs the suites whose name contains the filter, or all of them when it is empty.
+    // Returns false if any suite found a mismatch.
+    bool run(const std::string& filter)
+    {
+        bool passed = true;
+        for (const auto& suite : _suites)
+        {
+            if (std::string(suite.name).find(filter) == std::string::npos)
+            {
+                continue;
+            }
+
+            console::log("%s", suite.name);
+            if (!suite.run())
+            {
+                console::error("%s: results differ", suite.name);
+                passed = false;
+            }
+        }
+        return passed;
+    }
+}
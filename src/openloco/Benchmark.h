@@ -0,0 +1,26 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace openloco::benchmark
+{
+    using clock = std::chrono::steady_clock;
+
+    void report(const char* name, uint32_t iterations, clock::duration time);
+
+    // Times a number of calls of fn, which is passed the index of each call, and logs the average time of one
+    template<typename TFunc>
+    void measure(const char* name, uint32_t iterations, TFunc fn)
+    {
+        auto start = clock::now();
+        for (uint32_t i = 0; i < iterations; i++)
+        {
+            fn(i);
+        }
+        report(name, iterations, clock::now() - start);
+    }
+
+    bool run(const std::string& filter);
+}
@@ -0,0 +1,162 @@
+#include "CommandLine.h"
+#include "console.h"
+#include "utility/string.hpp"
+#include <cstdlib>
+
+namespace openloco
+{
+    static CommandLineOptions _options;
+
+    static void printUsage()
+    {
+        console::log("usage: openloco [simulate <path> <ticks> | benchmark [<name>]] [--tick-profile <csv path>] [--record-commands | --replay-commands] [--checksum-log <csv path> [--checksum-interval <ticks>]]");
+    }
+
+    // Parses a positive decimal number
+    static bool parsePositive(const std::string& arg, uint32_t& value)
+    {
+        char* end = nullptr;
+        auto result = std::strtoul(arg.c_str(), &end, 10);
+        if (end == arg.c_str() || *end != '\0' || result == 0)
+        {
+            return false;
+        }
+        value = static_cast<uint32_t>(result);
+        return true;
+    }
+
+    // argv[0] is expected to be the executable path and is ignored. Only a malformed action fails,
+    // other problems are reported and the arguments concerned ignored.
+    std::optional<CommandLineOptions> parseCommandLine(const std::vector<std::string>& argv)
+    {
+        CommandLineOptions options;
+        std::vector<std::string> positional;
+        for (size_t i = 1; i < argv.size(); i++)
+        {
+            const auto& arg = argv[i];
+            const bool takesValue = utility::iequals(arg, "--tick-profile") || utility::iequals(arg, "--checksum-log") || utility::iequals(arg, "--checksum-interval");
+            if (takesValue && i + 1 >= argv.size())
+            {
+                console::error("Missing value for '%s'", arg.c_str());
+                break;
+            }
+
+            if (utility::iequals(arg, "--tick-profile"))
+            {
+                options.tickProfilePath = argv[++i];
+            }
+            else if (utility::iequals(arg, "--checksum-log"))
+            {
+                options.checksumLogPath = argv[++i];
+            }
+            else if (utility::iequals(arg, "--checksum-interval"))
+            {
+                if (!parsePositive(argv[++i], options.checksumInterval))
+                {
+                    console::error("Invalid checksum interval '%s', using %u", argv[i].c_str(), options.checksumInterval);
+                }
+            }
+            else if (utility::iequals(arg, "--record-commands"))
+            {
+                options.recordCommands = true;
+            }
+            else if (utility::iequals(arg, "--replay-commands"))
+            {
+                options.replayCommands = true;
+            }
+            else
+            {
+                positional.push_back(arg);
+            }
+        }
+
+        if (!positional.empty() && utility::iequals(positional[0], "benchmark"))
+        {
+            if (positional.size() > 2)
+            {
+                printUsage();
+                return std::nullopt;
+            }
+
+            options.action = CommandLineAction::benchmark;
+            if (positional.size() == 2)
+            {
+                options.benchmarkFilter = positional[1];
+            }
+            return options;
+        }
+
+        // Other arguments were ignored before any actions existed and still are
+        if (positional.empty() || !utility::iequals(positional[0], "simulate"))
+        {
+            return options;
+        }
+
+        if (positional.size() != 3)
+        {
+            printUsage();
+            return std::nullopt;
+        }
+
+        if (!parsePositive(positional[2], options.ticks))
+        {
+            console::error("simulate: invalid number of ticks '%s'", positional[2].c_str());
+            return std::nullopt;
+        }
+
+        options.action = CommandLineAction::simulate;
+        options.path = positional[1];
+        return options;
+    }
+
+    // Splits a Windows style command line string. Double quotes group arguments containing spaces.
+    std::vector<std::string> splitCommandLine(const char* commandLine)
+    {
+        std::vector<std::string> result;
+        if (commandLine == nullptr)
+        {
+            return result;
+        }
+
+        std::string current;
+        bool inQuotes = false;
+        bool hasArgument = false;
+        for (auto ch = commandLine; *ch != '\0'; ch++)
+        {
+            if (*ch == '"')
+            {
+                inQuotes = !inQuotes;
+                hasArgument = true;
+            }
+            else if ((*ch == ' ' || *ch == '\t') && !inQuotes)
+            {
+                if (hasArgument)
+                {
+                    result.push_back(current);
+                    current.clear();
+                    hasArgument = false;
+                }
+            }
+            else
+            {
+                current.push_back(*ch);
+                hasArgument = true;
+            }
+        }
+        if (hasArgument)
+        {
+            result.push_back(current);
+        }
+        return result;
+    }
+
+    const CommandLineOptions& getCommandLineOptions()
+    {
+        return _options;
+    }
+
+    void setCommandLineOptions(const CommandLineOptions& options)
+    {
+        _options = options;
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "core/Optional.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace openloco
+{
+    enum class CommandLineAction
+    {
+        none,
+        simulate,
+        benchmark,
+    };
+
+    struct CommandLineOptions
+    {
+        CommandLineAction action = CommandLineAction::none;
+        std::string path;
+        uint32_t ticks = 0;
+        std::string tickProfilePath;
+        bool recordCommands = false;
+        bool replayCommands = false;
+        std::string checksumLogPath;
+        uint32_t checksumInterval = 100;
+        std::string benchmarkFilter;
+    };
+
+    std::optional<CommandLineOptions> parseCommandLine(const std::vector<std::string>& argv);
+    std::vector<std::string> splitCommandLine(const char* commandLine);
+    const CommandLineOptions& getCommandLineOptions();
+    void setCommandLineOptions(const CommandLineOptions& options);
+}
@@ -0,0 +1,102 @@
+#include "FramePacer.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+namespace openloco
+{
+    FramePacer::FramePacer(clock::duration frameTime)
+        : _frameTime(frameTime)
+        , _frameStart(clock::now())
+    {
+#ifdef _WIN32
+        // The default timer resolution of 15.6 ms is too coarse to sleep within a frame
+        timeBeginPeriod(1);
+#endif
+    }
+
+    FramePacer::~FramePacer()
+    {
+#ifdef _WIN32
+        timeEndPeriod(1);
+#endif
+    }
+
+    void FramePacer::beginFrame()
+    {
+        _frameStart = clock::now();
+    }
+
+    // Sleeps until the frame time has passed since the last call to beginFrame.
+    void FramePacer::waitForNextFrame()
+    {
+        auto workTime = elapsed();
+        record(workTime);
+
+        if (workTime < _frameTime)
+        {
+            auto deadline = _frameStart + _frameTime;
+            if (_frameTime - workTime > yieldTime)
+            {
+                std::this_thread::sleep_until(deadline - yieldTime);
+            }
+            while (clock::now() < deadline)
+            {
+                std::this_thread::yield();
+            }
+        }
+        else
+        {
+            _overruns++;
+        }
+    }
+
+    FramePacer::clock::duration FramePacer::elapsed() const
+    {
+        return clock::now() - _frameStart;
+    }
+
+    FramePacer::Stats FramePacer::getStats() const
+    {
+        using ms = std::chrono::duration<double, std::milli>;
+
+        Stats stats;
+        stats.frames = static_cast<uint32_t>(_historyCount);
+        stats.overruns = _overruns;
+        if (_historyCount == 0)
+        {
+            return stats;
+        }
+
+        std::vector<clock::duration> sorted(_history.begin(), _history.begin() + _historyCount);
+        std::sort(sorted.begin(), sorted.end());
+
+        clock::duration total{};
+        for (auto time : sorted)
+        {
+            total += time;
+        }
+
+        auto mostRecent = (_historyIndex + historySize - 1) % historySize;
+        stats.lastMs = ms(_history[mostRecent]).count();
+        stats.minMs = ms(sorted.front()).count();
+        stats.maxMs = ms(sorted.back()).count();
+        stats.averageMs = ms(total).count() / _historyCount;
+        stats.p99Ms = ms(sorted[(sorted.size() - 1) * 99 / 100]).count();
+        return stats;
+    }
+
+    void FramePacer::record(clock::duration workTime)
+    {
+        _history[_historyIndex] = workTime;
+        _historyIndex = (_historyIndex + 1) % historySize;
+        _historyCount = std::min(_historyCount + 1, historySize);
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace openloco
+{
+    /**
+     * Keeps a loop running at a fixed frame time by sleeping for most of the remainder of
+     * each frame, yielding for the last moment, and records how long recent frames took.
+     */
+    class FramePacer
+    {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        struct Stats
+        {
+            uint32_t frames{};   // Number of frames in the rolling window
+            double lastMs{};     // Work time of the most recent frame
+            double minMs{};      // Minimum work time within the window
+            double averageMs{};  // Average work time within the window
+            double maxMs{};      // Maximum work time within the window
+            double p99Ms{};      // 99th percentile work time within the window
+            uint64_t overruns{}; // Total frames that took longer than the frame time
+        };
+
+    private:
+        static constexpr size_t historySize = 64;
+
+        // Sleeps can overshoot by up to a scheduler quantum, so stop sleeping this long before the deadline
+        static constexpr auto yieldTime = std::chrono::milliseconds(2);
+
+        clock::duration _frameTime;
+        clock::time_point _frameStart;
+        std::array<clock::duration, historySize> _history{};
+        size_t _historyIndex{};
+        size_t _historyCount{};
+        uint64_t _overruns{};
+
+    public:
+        explicit FramePacer(clock::duration frameTime);
+        ~FramePacer();
+
+        FramePacer(const FramePacer&) = delete;
+        FramePacer& operator=(const FramePacer&) = delete;
+
+        void beginFrame();
+        void waitForNextFrame();
+        clock::duration elapsed() const;
+        Stats getStats() const;
+
+    private:
+        void record(clock::duration workTime);
+    };
+}
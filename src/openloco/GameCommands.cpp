@@ -1,11 +1,14 @@
+#include "Replay.h"
 #include "audio/audio.h"
 #include "company.h"
 #include "companymgr.h"
 #include "game_commands.h"
+#include "industrymgr.h"
 #include "map/tile.h"
 #include "objects/objectmgr.h"
 #include "objects/road_object.h"
 #include "objects/track_object.h"
+#include "openloco.h"
 #include "stationmgr.h"
 #include "things/vehicle.h"
 #include "ui/WindowManager.h"
@@ -77,6 +80,8 @@ namespace openloco::game_commands
             return loc_4313C6(esi, regs);
         }
 
+        replay::recordCommand(esi, regs);
+
         if ((flags & (GameCommandFlag::flag_4 | GameCommandFlag::flag_6)) != 0
             && _4F9688[esi] == 1
             && _updating_company_id == _player_company[0])
@@ -95,6 +100,8 @@ namespace openloco::game_commands
                 WindowManager::invalidate(WindowType::timeToolbar);
             }
 
+            setFastForward(FastForward::off);
+
             if (is_paused())
             {
                 gGameCommandErrorText = string_ids::empty;
@@ -171,6 +178,13 @@ namespace openloco::game_commands
         int32_t ebx2 = fnRegs2.ebx;
         _gameCommandFlags = flagsBackup2;
 
+        // Industries created afterwards may reuse the slot. Creating an industry needs nothing
+        // more, as a slot without a valid index of its own is rebuilt when it is first updated.
+        if (esi == static_cast<int>(GameCommand::industry_remove))
+        {
+            industrymgr::invalidateOwnedTiles(static_cast<industry_id_t>(regs.dx));
+        }
+
         if (ebx2 == static_cast<int32_t>(0x80000000))
         {
             return loc_4314EA();
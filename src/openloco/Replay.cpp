@@ -0,0 +1,225 @@
+#include "Replay.h"
+#include "CommandLine.h"
+#include "companymgr.h"
+#include "console.h"
+#include "game_commands.h"
+#include "openloco.h"
+#include "utility/string.hpp"
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+using namespace openloco::interop;
+
+namespace openloco::replay
+{
+    static loco_global<company_id_t, 0x009C68EB> _updating_company_id;
+
+    constexpr char logMagic[4] = { 'O', 'L', 'C', 'R' };
+    constexpr uint16_t logVersion = 1;
+
+    // Loading, saving and quitting end the recorded session rather than change it
+    constexpr int loadSaveQuitCommand = 21;
+
+#pragma pack(push, 1)
+    struct LogHeader
+    {
+        char magic[4];
+        uint16_t version;
+        uint32_t startTick;
+    };
+    static_assert(sizeof(LogHeader) == 10);
+
+    struct LogEntry
+    {
+        uint32_t tick;
+        uint8_t command;
+        int32_t eax;
+        int32_t ebx;
+        int32_t ecx;
+        int32_t edx;
+        int32_t esi;
+        int32_t edi;
+        int32_t ebp;
+    };
+    static_assert(sizeof(LogEntry) == 33);
+#pragma pack(pop)
+
+    static std::ofstream _recording;
+    static fs::path _recordingPath;
+    static std::vector<LogEntry> _playback;
+    static size_t _playbackIndex;
+    static bool _isPlaying;
+    static bool _isInTick;
+
+    // The log of commands applied since loading a saved game is kept next to it
+    fs::path getLogPath(const fs::path& savePath)
+    {
+        auto path = savePath;
+        path += ".commands";
+        return path;
+    }
+
+    static void startRecording(const fs::path& path)
+    {
+        _recording.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!_recording.is_open())
+        {
+            console::error("Unable to open command log for recording: %s", path.u8string().c_str());
+            return;
+        }
+
+        LogHeader header;
+        std::copy(std::begin(logMagic), std::end(logMagic), header.magic);
+        header.version = logVersion;
+        header.startTick = scenario_ticks();
+        _recording.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        _recordingPath = path;
+        console::log("Recording game commands to %s", path.u8string().c_str());
+    }
+
+    static void startPlayback(const fs::path& path)
+    {
+        std::ifstream file(path, std::ios::in | std::ios::binary);
+        LogHeader header;
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))
+            || !std::equal(std::begin(logMagic), std::end(logMagic), header.magic)
+            || header.version != logVersion)
+        {
+            console::error("Unable to read command log: %s", path.u8string().c_str());
+            return;
+        }
+
+        if (header.startTick != scenario_ticks())
+        {
+            console::error("Command log was recorded from tick %u but the game is at tick %u", header.startTick, scenario_ticks());
+        }
+
+        LogEntry entry;
+        while (file.read(reinterpret_cast<char*>(&entry), sizeof(entry)))
+        {
+            _playback.push_back(entry);
+        }
+
+        _playbackIndex = 0;
+        _isPlaying = true;
+        console::log("Replaying %u game commands from %s", static_cast<uint32_t>(_playback.size()), path.u8string().c_str());
+    }
+
+    // Starts recording or replaying the commands of a saved game, as requested on the command line.
+    void onGameLoaded(const fs::path& path)
+    {
+        stop();
+
+        if (!utility::iequals(path.extension().u8string(), ".sv5"))
+        {
+            return;
+        }
+
+        const auto& options = getCommandLineOptions();
+        if (options.replayCommands)
+        {
+            startPlayback(getLogPath(path));
+        }
+        else if (options.recordCommands)
+        {
+            startRecording(getLogPath(path));
+        }
+    }
+
+    void stop()
+    {
+        if (_recording.is_open())
+        {
+            _recording.close();
+            console::log("Finished recording game commands to %s", _recordingPath.u8string().c_str());
+        }
+
+        _playback.clear();
+        _playbackIndex = 0;
+        _isPlaying = false;
+        _isInTick = false;
+    }
+
+    bool isRecording()
+    {
+        return _recording.is_open();
+    }
+
+    bool isPlaying()
+    {
+        return _isPlaying;
+    }
+
+    static void playCommand(const LogEntry& entry)
+    {
+        registers regs;
+        regs.eax = entry.eax;
+        regs.ebx = entry.ebx;
+        regs.ecx = entry.ecx;
+        regs.edx = entry.edx;
+        regs.esi = entry.esi;
+        regs.edi = entry.edi;
+        regs.ebp = entry.ebp;
+
+        // Commands were recorded as issued by the player
+        company_id_t updatingCompanyId = _updating_company_id;
+        _updating_company_id = companymgr::get_controlling_id();
+        game_commands::do_command(entry.command, regs);
+        _updating_company_id = updatingCompanyId;
+    }
+
+    // Commands are recorded after the tick they were issued in, so they are played before the next tick starts.
+    void beginTick()
+    {
+        if (_isPlaying)
+        {
+            const auto tick = scenario_ticks();
+            while (_playbackIndex < _playback.size() && _playback[_playbackIndex].tick <= tick)
+            {
+                const auto& entry = _playback[_playbackIndex++];
+                if (entry.tick != tick)
+                {
+                    console::error("Game command %u recorded at tick %u replayed at tick %u", entry.command, entry.tick, tick);
+                }
+                playCommand(entry);
+            }
+
+            if (_playbackIndex >= _playback.size())
+            {
+                console::log("Finished replaying game commands at tick %u", tick);
+                _playback.clear();
+                _isPlaying = false;
+            }
+        }
+
+        _isInTick = true;
+    }
+
+    void endTick()
+    {
+        _isInTick = false;
+    }
+
+    // Commands issued during a tick come from the simulation itself and are repeated by it during playback.
+    void recordCommand(int esi, const registers& regs)
+    {
+        if (!_recording.is_open() || _isInTick || _isPlaying || esi == loadSaveQuitCommand)
+        {
+            return;
+        }
+
+        LogEntry entry;
+        entry.tick = scenario_ticks();
+        entry.command = static_cast<uint8_t>(esi);
+        entry.eax = regs.eax;
+        entry.ebx = regs.ebx;
+        entry.ecx = regs.ecx;
+        entry.edx = regs.edx;
+        entry.esi = regs.esi;
+        entry.edi = regs.edi;
+        entry.ebp = regs.ebp;
+        _recording.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+        _recording.flush();
+    }
+}
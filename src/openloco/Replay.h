@@ -0,0 +1,17 @@
+#pragma once
+
+#include "core/FileSystem.hpp"
+#include "interop/interop.hpp"
+#include <cstdint>
+
+namespace openloco::replay
+{
+    fs::path getLogPath(const fs::path& savePath);
+    void onGameLoaded(const fs::path& path);
+    void stop();
+    bool isRecording();
+    bool isPlaying();
+    void beginTick();
+    void endTick();
+    void recordCommand(int esi, const interop::registers& regs);
+}
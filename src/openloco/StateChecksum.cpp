@@ -0,0 +1,182 @@
+#include "StateChecksum.h"
+#include "company.h"
+#include "companymgr.h"
+#include "console.h"
+#include "industry.h"
+#include "industrymgr.h"
+#include "interop/interop.hpp"
+#include "map/tilemgr.h"
+#include "openloco.h"
+#include "station.h"
+#include "stationmgr.h"
+#include "things/thing.h"
+#include "things/thingmgr.h"
+#include "town.h"
+#include "townmgr.h"
+#include "utility/hash.hpp"
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+
+using namespace openloco::interop;
+
+namespace openloco::statechecksum
+{
+    // Everything between the PRNG and the company colours is written to saved games
+    constexpr uint32_t gameStateBegin = 0x00525E18;
+    constexpr uint32_t gameStateEnd = 0x009C645C;
+
+    struct MemoryRegion
+    {
+        Region region;
+        uint32_t begin;
+        uint32_t size;
+    };
+
+    // Sorted by address, the gaps between them make up Region::other
+    static constexpr MemoryRegion _memoryRegions[] = {
+        { Region::prng, 0x00525E18, 8 },
+        { Region::companies, 0x00531784, sizeof(company) * companymgr::max_companies },
+        { Region::towns, 0x005B825C, sizeof(town) * townmgr::max_towns },
+        { Region::industries, 0x005C455C, sizeof(industry) * industrymgr::max_industries },
+        { Region::stations, 0x005E6EDC, sizeof(station) * stationmgr::max_stations },
+        { Region::things, 0x006DB6DC, sizeof(Thing) * thingmgr::max_things },
+    };
+
+    static constexpr bool areMemoryRegionsOrdered()
+    {
+        uint32_t address = gameStateBegin;
+        for (const auto& memory : _memoryRegions)
+        {
+            if (memory.begin < address)
+            {
+                return false;
+            }
+            address = memory.begin + memory.size;
+        }
+        return address <= gameStateEnd;
+    }
+    static_assert(areMemoryRegionsOrdered());
+
+    static constexpr const char* _regionNames[] = {
+        "prng",
+        "companies",
+        "towns",
+        "industries",
+        "stations",
+        "things",
+        "other",
+        "tiles",
+    };
+    static_assert(std::size(_regionNames) == regionCount);
+
+    static FILE* _log;
+    static uint32_t _interval = 1;
+    static uint32_t _rolling;
+
+    const char* getRegionName(Region region)
+    {
+        return _regionNames[static_cast<size_t>(region)];
+    }
+
+    static const uint8_t* getMemory(uint32_t address)
+    {
+        return reinterpret_cast<const uint8_t*>(remap_address(address));
+    }
+
+    // Hashes the state in place rather than snapshotting it with interop::save_state, which would copy several megabytes each time.
+    Checksum compute()
+    {
+        Checksum result;
+
+        utility::XxHash32 other;
+        uint32_t address = gameStateBegin;
+        for (const auto& memory : _memoryRegions)
+        {
+            other.update(getMemory(address), memory.begin - address);
+            result.regions[static_cast<size_t>(memory.region)] = utility::xxHash32(getMemory(memory.begin), memory.size);
+            address = memory.begin + memory.size;
+        }
+        other.update(getMemory(address), gameStateEnd - address);
+        result.regions[static_cast<size_t>(Region::other)] = other.digest();
+
+        utility::XxHash32 tiles;
+        for (coord_t y = 0; y < map::map_height; y += map::tile_size)
+        {
+            for (coord_t x = 0; x < map::map_width; x += map::tile_size)
+            {
+                auto tile = map::tilemgr::get(x, y);
+                if (tile.is_null())
+                {
+                    continue;
+                }
+                tiles.update(tile.begin(), tile.size() * sizeof(map::tile_element));
+            }
+        }
+        result.regions[static_cast<size_t>(Region::tiles)] = tiles.digest();
+
+        result.total = utility::xxHash32(result.regions.data(), result.regions.size() * sizeof(uint32_t));
+        return result;
+    }
+
+    // Writes the checksums every interval ticks. Each line also carries a rolling checksum of all lines
+    // before it, so comparing the last lines of two logs tells whether the runs were identical.
+    bool startLog(const fs::path& path, uint32_t interval)
+    {
+        stopLog();
+
+        _log = std::fopen(path.u8string().c_str(), "w");
+        if (_log == nullptr)
+        {
+            console::error("Unable to open state checksum log '%s'", path.u8string().c_str());
+            return false;
+        }
+
+        _interval = std::max<uint32_t>(interval, 1);
+        _rolling = 0;
+        std::fprintf(_log, "tick,rolling,total");
+        for (auto name : _regionNames)
+        {
+            std::fprintf(_log, ",%s", name);
+        }
+        std::fprintf(_log, "\n");
+
+        console::log("Logging state checksums every %u ticks to '%s'", _interval, path.u8string().c_str());
+        return true;
+    }
+
+    void stopLog()
+    {
+        if (_log != nullptr)
+        {
+            std::fclose(_log);
+            _log = nullptr;
+        }
+    }
+
+    // Called after every tick
+    void update()
+    {
+        if (_log == nullptr)
+        {
+            return;
+        }
+
+        auto tick = scenario_ticks();
+        if (tick % _interval != 0)
+        {
+            return;
+        }
+
+        auto checksum = compute();
+        uint32_t chain[] = { _rolling, checksum.total };
+        _rolling = utility::xxHash32(chain, sizeof(chain));
+
+        std::fprintf(_log, "%u,%08" PRIX32 ",%08" PRIX32, tick, _rolling, checksum.total);
+        for (auto region : checksum.regions)
+        {
+            std::fprintf(_log, ",%08" PRIX32, region);
+        }
+        std::fprintf(_log, "\n");
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "core/FileSystem.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace openloco::statechecksum
+{
+    // Parts of the simulation state that are checksummed separately so a divergence can be traced to one of them
+    enum class Region : uint8_t
+    {
+        prng,
+        companies,
+        towns,
+        industries,
+        stations,
+        things,
+        other, // Remainder of the saved game state
+        tiles,
+        count,
+    };
+
+    constexpr size_t regionCount = static_cast<size_t>(Region::count);
+
+    struct Checksum
+    {
+        std::array<uint32_t, regionCount> regions{};
+        uint32_t total{};
+    };
+
+    const char* getRegionName(Region region);
+    Checksum compute();
+
+    bool startLog(const fs::path& path, uint32_t interval);
+    void stopLog();
+    void update();
+}
@@ -0,0 +1,183 @@
+#include "TickProfiler.h"
+#include "console.h"
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+
+namespace openloco::tickprofiler
+{
+    static constexpr size_t historySize = 256;
+
+    struct StageHistory
+    {
+        std::array<clock::duration, historySize> samples{};
+        size_t index{};
+        size_t count{};
+    };
+
+    static constexpr const char* _stageNames[] = {
+        "tick",
+        "date",
+        "date_monthly",
+        "date_yearly",
+        "towns",
+        "industries",
+        "vehicles",
+        "stations",
+        "misc_things",
+        "companies",
+        "map_animations",
+        "audio",
+    };
+    static_assert(std::size(_stageNames) == stageCount);
+
+    static std::array<StageHistory, stageCount> _history;
+
+    // Start time of each stage that has begun but not yet ended
+    static std::array<clock::time_point, stageCount> _stageStarts;
+    static std::array<bool, stageCount> _openStages;
+
+    // Time spent in each stage during the tick currently being recorded to the CSV
+    static std::array<clock::duration, stageCount> _currentRow{};
+    static std::ofstream _csv;
+    static fs::path _csvPath;
+    static uint64_t _csvRow;
+
+    const char* getStageName(Stage stage)
+    {
+        return _stageNames[static_cast<size_t>(stage)];
+    }
+
+    static void writeCsvRow()
+    {
+        using us = std::chrono::duration<double, std::micro>;
+
+        _csv << _csvRow++;
+        for (auto time : _currentRow)
+        {
+            _csv << ',' << us(time).count();
+        }
+        _csv << '\n';
+    }
+
+    // Recording the tick stage completes the row of the current tick.
+    void record(Stage stage, clock::duration time)
+    {
+        auto& history = _history[static_cast<size_t>(stage)];
+        history.samples[history.index] = time;
+        history.index = (history.index + 1) % historySize;
+        history.count = std::min(history.count + 1, historySize);
+
+        _currentRow[static_cast<size_t>(stage)] += time;
+        if (stage == Stage::tick)
+        {
+            if (_csv.is_open())
+            {
+                writeCsvRow();
+            }
+            _currentRow.fill(clock::duration::zero());
+        }
+    }
+
+    void begin(Stage stage)
+    {
+        _stageStarts[static_cast<size_t>(stage)] = clock::now();
+        _openStages[static_cast<size_t>(stage)] = true;
+    }
+
+    void end(Stage stage)
+    {
+        auto index = static_cast<size_t>(stage);
+        if (_openStages[index])
+        {
+            _openStages[index] = false;
+            record(stage, clock::now() - _stageStarts[index]);
+        }
+    }
+
+    // Called when loco ends a tick prematurely. The partial tick is not recorded.
+    void abandonOpenStages()
+    {
+        _openStages.fill(false);
+        _currentRow.fill(clock::duration::zero());
+    }
+
+    StageStats getStats(Stage stage)
+    {
+        using ms = std::chrono::duration<double, std::milli>;
+
+        const auto& history = _history[static_cast<size_t>(stage)];
+
+        StageStats stats;
+        stats.samples = static_cast<uint32_t>(history.count);
+        if (history.count == 0)
+        {
+            return stats;
+        }
+
+        std::vector<clock::duration> sorted(history.samples.begin(), history.samples.begin() + history.count);
+        std::sort(sorted.begin(), sorted.end());
+
+        clock::duration total{};
+        for (auto time : sorted)
+        {
+            total += time;
+        }
+
+        auto mostRecent = (history.index + historySize - 1) % historySize;
+        stats.lastMs = ms(history.samples[mostRecent]).count();
+        stats.minMs = ms(sorted.front()).count();
+        stats.maxMs = ms(sorted.back()).count();
+        stats.averageMs = ms(total).count() / history.count;
+        stats.p99Ms = ms(sorted[(sorted.size() - 1) * 99 / 100]).count();
+        return stats;
+    }
+
+    // Writes one row per tick with the time in microseconds of each stage.
+    bool startCsv(const fs::path& path)
+    {
+        stopCsv();
+
+        _csv.open(path, std::ios::out | std::ios::trunc);
+        if (!_csv.is_open())
+        {
+            console::error("Unable to open tick profile '%s'", path.u8string().c_str());
+            return false;
+        }
+
+        _csvPath = path;
+        _csvRow = 0;
+        _csv << std::fixed << std::setprecision(1) << "row";
+        for (auto name : _stageNames)
+        {
+            _csv << ',' << name;
+        }
+        _csv << '\n';
+
+        console::log("Recording tick profile to '%s'", path.u8string().c_str());
+        return true;
+    }
+
+    void stopCsv()
+    {
+        if (!_csv.is_open())
+        {
+            return;
+        }
+
+        _csv.close();
+        console::log("Recorded %llu ticks to '%s'", static_cast<unsigned long long>(_csvRow), _csvPath.u8string().c_str());
+    }
+
+    bool isRecordingCsv()
+    {
+        return _csv.is_open();
+    }
+
+    const fs::path& getCsvPath()
+    {
+        return _csvPath;
+    }
+}
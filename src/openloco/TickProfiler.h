@@ -0,0 +1,56 @@
+#pragma once
+
+#include "core/FileSystem.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace openloco::tickprofiler
+{
+    // Stages of tick_logic. The date stage includes the monthly stage, which in turn includes the yearly stage.
+    enum class Stage : uint8_t
+    {
+        tick,
+        date,
+        dateMonthly,
+        dateYearly,
+        towns,
+        industries,
+        vehicles,
+        stations,
+        miscThings,
+        companies,
+        mapAnimations,
+        audio,
+        count,
+    };
+
+    constexpr size_t stageCount = static_cast<size_t>(Stage::count);
+
+    using clock = std::chrono::steady_clock;
+
+    struct StageStats
+    {
+        uint32_t samples{}; // Number of samples in the rolling window
+        double lastMs{};    // Most recent sample
+        double minMs{};     // Minimum within the window
+        double averageMs{}; // Average within the window
+        double maxMs{};     // Maximum within the window
+        double p99Ms{};     // 99th percentile within the window
+    };
+
+    const char* getStageName(Stage stage);
+    void record(Stage stage, clock::duration time);
+    StageStats getStats(Stage stage);
+
+    bool startCsv(const fs::path& path);
+    void stopCsv();
+    bool isRecordingCsv();
+    const fs::path& getCsvPath();
+
+    // Stages are opened and closed explicitly rather than by scope because loco can end a tick
+    // prematurely by jumping straight back to tick(), which would skip any destructors.
+    void begin(Stage stage);
+    void end(Stage stage);
+    void abandonOpenStages();
+}
@@ -897,6 +897,9 @@ namespace openloco::audio
     // 0x48A73B
     void updateVehicleNoise()
     {
+        if (!_audio_initialised)
+            return;
+
         if (addr<0x00525E28, uint32_t>() & 1)
         {
             if (!_audioIsPaused && _audioIsEnabled)
@@ -46,19 +46,11 @@ namespace openloco
     // 0x00437ED0
     void company::recalculateTransportCounts()
     {
-        // Reset all counts to 0
-        for (auto& count : transportTypeCount)
-        {
-            count = 0;
-        }
-
         auto companyId = id();
-        for (auto v : thingmgr::VehicleList())
+        for (uint8_t type = 0; type < vehicleTypeCount; type++)
         {
-            if (v->owner == companyId)
-            {
-                transportTypeCount[static_cast<uint8_t>(v->vehicleType)]++;
-            }
+            const auto& vehicles = thingmgr::getCompanyVehicles(companyId, static_cast<VehicleType>(type));
+            transportTypeCount[type] = static_cast<uint16_t>(vehicles.size());
         }
 
         ui::WindowManager::invalidate(ui::WindowType::company, companyId);
@@ -1,5 +1,7 @@
 
+#include <algorithm>
 #include <fstream>
+#include <limits>
 
 #ifdef _WIN32
 #include <shlobj.h>
@@ -45,6 +47,14 @@ namespace openloco::config
         write_new_config();
     }
 
+    // The drawing engine clamps the shift to the range it supports. Clamping here only keeps out of range
+    // values from wrapping when narrowed, so that they still end up at the nearest supported shift.
+    static uint8_t read_dirty_block_shift(const YAML::Node& node, int32_t defaultValue)
+    {
+        auto shift = node.as<int32_t>(defaultValue);
+        return static_cast<uint8_t>(std::clamp<int32_t>(shift, 0, std::numeric_limits<uint8_t>::max()));
+    }
+
     new_config& read_new_config()
     {
         auto configPath = environment::get_path(environment::path_id::openloco_yml);
@@ -64,6 +74,8 @@ namespace openloco::config
             displayConfig.index = displayNode["index"].as<int32_t>(0);
             displayConfig.window_resolution = displayNode["window_resolution"].as<resolution_t>();
             displayConfig.fullscreen_resolution = displayNode["fullscreen_resolution"].as<resolution_t>();
+            displayConfig.dirty_block_width_shift = read_dirty_block_shift(displayNode["dirty_block_width_shift"], 6);
+            displayConfig.dirty_block_height_shift = read_dirty_block_shift(displayNode["dirty_block_height_shift"], 3);
         }
 
         auto& audioNode = config["audio"];
@@ -87,6 +99,10 @@ namespace openloco::config
             _new_config.scale_factor = config["scale_factor"].as<float>();
         if (config["zoom_to_cursor"])
             _new_config.zoom_to_cursor = config["zoom_to_cursor"].as<bool>();
+        if (config["particle_budget"])
+            _new_config.particle_budget = config["particle_budget"].as<uint16_t>();
+        if (config["misc_thing_headroom"])
+            _new_config.misc_thing_headroom = config["misc_thing_headroom"].as<uint16_t>();
 
         return _new_config;
     }
@@ -124,6 +140,8 @@ namespace openloco::config
         }
         displayNode["window_resolution"] = displayConfig.window_resolution;
         displayNode["fullscreen_resolution"] = displayConfig.fullscreen_resolution;
+        displayNode["dirty_block_width_shift"] = static_cast<int32_t>(displayConfig.dirty_block_width_shift);
+        displayNode["dirty_block_height_shift"] = static_cast<int32_t>(displayConfig.dirty_block_height_shift);
         node["display"] = displayNode;
 
         // Audio
@@ -143,6 +161,8 @@ namespace openloco::config
         node["companyAIDisabled"] = _new_config.companyAIDisabled;
         node["scale_factor"] = _new_config.scale_factor;
         node["zoom_to_cursor"] = _new_config.zoom_to_cursor;
+        node["particle_budget"] = _new_config.particle_budget;
+        node["misc_thing_headroom"] = _new_config.misc_thing_headroom;
 
         std::ofstream stream(configPath);
         if (stream.is_open())
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 
@@ -135,6 +136,8 @@ namespace openloco::config
         int32_t index{};
         resolution_t window_resolution = { 800, 600 };
         resolution_t fullscreen_resolution;
+        uint8_t dirty_block_width_shift = 6;  // Redrawn blocks are 1 << shift pixels wide
+        uint8_t dirty_block_height_shift = 3; // Redrawn blocks are 1 << shift pixels high
     };
 
     struct audio_config
@@ -153,6 +156,8 @@ namespace openloco::config
         bool companyAIDisabled = false;
         float scale_factor = 1.0f;
         bool zoom_to_cursor = true;
+        uint16_t particle_budget = 0;     // No smoke or exhaust is created while this many misc things exist, 0 for no limit
+        uint16_t misc_thing_headroom = 0; // Free things that misc things may not take, kept for vehicles
     };
 
 #pragma pack(pop)
@@ -2,6 +2,7 @@
 #include "../interop/interop.hpp"
 #include "../ui.h"
 #include "../ui/WindowManager.h"
+#include "../utility/numeric.hpp"
 #include <algorithm>
 
 using namespace openloco::interop;
@@ -11,52 +12,95 @@ using namespace openloco::ui;
 namespace openloco::drawing
 {
     static loco_global<ui::screen_info_t, 0x0050B884> screen_info;
-    static loco_global<uint8_t[1], 0x00E025C4> _E025C4;
 
     static void window_draw(drawpixelinfo_t* dpi, ui::window* w, Rect rect);
     static void window_draw(drawpixelinfo_t* dpi, ui::window* w, int16_t left, int16_t top, int16_t right, int16_t bottom);
     static bool window_draw_split(gfx::drawpixelinfo_t* dpi, ui::window* w, int16_t left, int16_t top, int16_t right, int16_t bottom);
 
-    // T[m][n]
-    template<typename T>
-    class Grid
+    static constexpr size_t bitsPerWord = 64;
+
+    // Bits first to last inclusive of a word
+    static constexpr uint64_t getWordMask(size_t first, size_t last)
     {
-        T* ptr;
-        size_t m;
-        size_t n;
-
-    public:
-        Grid(T* data, const int32_t n, const int32_t m)
-            : ptr(data)
-            , m(m)
-            , n(n)
-        {
-        }
+        return (~uint64_t(0) >> (bitsPerWord - 1 - last)) & (~uint64_t(0) << first);
+    }
 
-        T* operator[](std::size_t idx)
+    // Calls fn(word, mask) for each word of a row covering the columns first to last inclusive
+    template<typename TFunc>
+    static void forEachWord(size_t first, size_t last, TFunc fn)
+    {
+        const size_t firstWord = first / bitsPerWord;
+        const size_t lastWord = last / bitsPerWord;
+        for (size_t word = firstWord; word <= lastWord; word++)
         {
-            return ptr + idx * n;
+            auto firstBit = word == firstWord ? first % bitsPerWord : 0;
+            auto lastBit = word == lastWord ? last % bitsPerWord : bitsPerWord - 1;
+            if (!fn(word, getWordMask(firstBit, lastBit)))
+            {
+                return;
+            }
         }
+    }
 
-        size_t getRows(size_t x, size_t dX, size_t y)
-        {
+    // Sizes the dirty block grid for a screen, with blocks of 1 << shift pixels, and marks every block dirty.
+    // The layout is also written to screen_info for loco code reading it.
+    void SoftwareDrawingEngine::resize(int32_t width, int32_t height, uint8_t blockWidthShift, uint8_t blockHeightShift)
+    {
+        _width = width;
+        _height = height;
+        _blockWidthShift = std::clamp(blockWidthShift, minDirtyBlockShift, maxDirtyBlockShift);
+        _blockHeightShift = std::clamp(blockHeightShift, minDirtyBlockShift, maxDirtyBlockShift);
+
+        _dirtyBlockColumns = (width >> _blockWidthShift) + 1;
+        _dirtyBlockRows = (height >> _blockHeightShift) + 1;
+        _dirtyBlockWordsPerRow = (_dirtyBlockColumns + bitsPerWord - 1) / bitsPerWord;
+        _dirtyBlocks.assign(_dirtyBlockWordsPerRow * _dirtyBlockRows, 0);
+        _dirtyColumns.assign(_dirtyBlockWordsPerRow, 0);
+        setDirtyBlocks(0, 0, width, height);
+
+        screen_info->dirty_block_width = 1 << _blockWidthShift;
+        screen_info->dirty_block_height = 1 << _blockHeightShift;
+        screen_info->dirty_block_columns = static_cast<int32_t>(_dirtyBlockColumns);
+        screen_info->dirty_block_rows = static_cast<int32_t>(_dirtyBlockRows);
+        screen_info->dirty_block_column_shift = _blockWidthShift;
+        screen_info->dirty_block_row_shift = _blockHeightShift;
+        screen_info->dirty_blocks_initialised = 1;
+    }
 
-            int dy = 0;
-            for (size_t yy = y; yy < this->m; yy++)
-            {
+    uint64_t* SoftwareDrawingEngine::getDirtyBlockRow(size_t y)
+    {
+        return _dirtyBlocks.data() + y * _dirtyBlockWordsPerRow;
+    }
 
-                for (size_t xx = x; xx < x + dX; xx++)
-                {
-                    if ((*this)[yy][xx] == 0)
-                    {
-                        return dy;
-                    }
-                }
-                dy++;
+    // Number of consecutive dirty blocks in a row starting at column x
+    size_t SoftwareDrawingEngine::getDirtyRun(size_t x, size_t y)
+    {
+        auto row = getDirtyBlockRow(y);
+        for (size_t word = x / bitsPerWord; word < _dirtyBlockWordsPerRow; word++)
+        {
+            auto clean = ~row[word];
+            if (word == x / bitsPerWord)
+            {
+                clean &= ~uint64_t(0) << (x % bitsPerWord);
+            }
+            if (clean != 0)
+            {
+                return word * bitsPerWord + utility::bitScanForward64(clean) - x;
             }
-            return dy;
         }
-    };
+        return _dirtyBlockWordsPerRow * bitsPerWord - x;
+    }
+
+    bool SoftwareDrawingEngine::isDirtyRun(size_t x, size_t y, size_t dx)
+    {
+        auto row = getDirtyBlockRow(y);
+        bool dirty = true;
+        forEachWord(x, x + dx - 1, [row, &dirty](size_t word, uint64_t mask) {
+            dirty = (row[word] & mask) == mask;
+            return dirty;
+        });
+        return dirty;
+    }
 
     /**
      * 0x004C5C69
@@ -70,8 +114,8 @@ namespace openloco::drawing
     {
         left = std::max(left, 0);
         top = std::max(top, 0);
-        right = std::min(right, (int32_t)screen_info->width);
-        bottom = std::min(bottom, (int32_t)screen_info->height);
+        right = std::min(right, _width);
+        bottom = std::min(bottom, _height);
 
         if (left >= right)
             return;
@@ -81,75 +125,97 @@ namespace openloco::drawing
         right--;
         bottom--;
 
-        const int32_t dirty_block_left = left >> screen_info->dirty_block_column_shift;
-        const int32_t dirty_block_right = right >> screen_info->dirty_block_column_shift;
-        const int32_t dirty_block_top = top >> screen_info->dirty_block_row_shift;
-        const int32_t dirty_block_bottom = bottom >> screen_info->dirty_block_row_shift;
+        const int32_t dirty_block_left = left >> _blockWidthShift;
+        const int32_t dirty_block_right = right >> _blockWidthShift;
+        const int32_t dirty_block_top = top >> _blockHeightShift;
+        const int32_t dirty_block_bottom = bottom >> _blockHeightShift;
 
-        const size_t columns = screen_info->dirty_block_columns;
-        const size_t rows = screen_info->dirty_block_rows;
-        auto grid = Grid<uint8_t>(_E025C4, columns, rows);
+        for (int32_t y = dirty_block_top; y <= dirty_block_bottom; y++)
+        {
+            auto row = getDirtyBlockRow(y);
+            forEachWord(dirty_block_left, dirty_block_right, [row](size_t word, uint64_t mask) {
+                row[word] |= mask;
+                return true;
+            });
+        }
+    }
 
-        for (int16_t y = dirty_block_top; y <= dirty_block_bottom; y++)
+    // Marks the columns that have any dirty blocks
+    void SoftwareDrawingEngine::updateDirtyColumns()
+    {
+        std::fill(_dirtyColumns.begin(), _dirtyColumns.end(), 0);
+        for (size_t y = 0; y < _dirtyBlockRows; y++)
         {
-            for (int16_t x = dirty_block_left; x <= dirty_block_right; x++)
+            auto row = getDirtyBlockRow(y);
+            for (size_t word = 0; word < _dirtyBlockWordsPerRow; word++)
             {
-                grid[y][x] = 0xFF;
+                _dirtyColumns[word] |= row[word];
             }
         }
     }
 
     // 0x004C5CFA
+    // Draws the dirty blocks as rectangles, taking columns left to right and rows top to bottom.
+    // Each rectangle extends right along its first row and then down while all of its columns are dirty.
     void SoftwareDrawingEngine::drawDirtyBlocks()
     {
-        const size_t columns = screen_info->dirty_block_columns;
-        const size_t rows = screen_info->dirty_block_rows;
-        auto grid = Grid<uint8_t>(_E025C4, columns, rows);
+        const size_t rows = _dirtyBlockRows;
 
-        for (size_t x = 0; x < columns; x++)
+        // Drawing a rectangle can dirty more blocks, so the columns still to visit are found again
+        // after each one, as loco finds blocks dirtied in columns to the right in the same frame
+        updateDirtyColumns();
+        for (size_t word = 0; word < _dirtyBlockWordsPerRow; word++)
         {
-            for (size_t y = 0; y < rows; y++)
+            auto columns = _dirtyColumns[word];
+            while (columns != 0)
             {
-                if (grid[y][x] == 0)
-                    continue;
-
-                // Determine columns
-                size_t xx;
-                for (xx = x; xx < columns; xx++)
+                const size_t x = word * bitsPerWord + utility::bitScanForward64(columns);
+                const uint64_t bit = uint64_t(1) << (x % bitsPerWord);
+                bool drawn = false;
+                for (size_t y = 0; y < rows; y++)
                 {
-                    if (grid[y][xx] == 0)
-                        break;
-                }
-                size_t dX = xx - x;
+                    if ((getDirtyBlockRow(y)[word] & bit) == 0)
+                        continue;
 
-                // Check rows
-                size_t dY = grid.getRows(x, dX, y);
+                    size_t dX = getDirtyRun(x, y);
+                    size_t dY = 1;
+                    while (y + dY < rows && isDirtyRun(x, y + dY, dX))
+                    {
+                        dY++;
+                    }
+
+                    drawDirtyBlocks(x, y, dX, dY);
+                    drawn = true;
+                }
 
-                drawDirtyBlocks(x, y, dX, dY);
+                if (drawn)
+                {
+                    updateDirtyColumns();
+                    columns = _dirtyColumns[word];
+                }
+                // Drop this column and those to its left
+                columns &= ~(bit | (bit - 1));
             }
         }
     }
 
     void SoftwareDrawingEngine::drawDirtyBlocks(size_t x, size_t y, size_t dx, size_t dy)
     {
-        const auto columns = screen_info->dirty_block_columns;
-        const auto rows = screen_info->dirty_block_rows;
-        auto grid = Grid<uint8_t>(_E025C4, columns, rows);
-
         // Unset dirty blocks
         for (size_t top = y; top < y + dy; top++)
         {
-            for (uint32_t left = x; left < x + dx; left++)
-            {
-                grid[top][left] = 0;
-            }
+            auto row = getDirtyBlockRow(top);
+            forEachWord(x, x + dx - 1, [row](size_t word, uint64_t mask) {
+                row[word] &= ~mask;
+                return true;
+            });
         }
 
         auto rect = Rect(
-            static_cast<int16_t>(x * screen_info->dirty_block_width),
-            static_cast<int16_t>(y * screen_info->dirty_block_height),
-            static_cast<uint16_t>(dx * screen_info->dirty_block_width),
-            static_cast<uint16_t>(dy * screen_info->dirty_block_height));
+            static_cast<int16_t>(x << _blockWidthShift),
+            static_cast<int16_t>(y << _blockHeightShift),
+            static_cast<uint16_t>(dx << _blockWidthShift),
+            static_cast<uint16_t>(dy << _blockHeightShift));
 
         this->drawRect(rect);
     }
@@ -4,17 +4,39 @@
 #include "../ui/Rect.h"
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <vector>
 
 namespace openloco::drawing
 {
     class SoftwareDrawingEngine
     {
     public:
+        static constexpr uint8_t minDirtyBlockShift = 2;
+        static constexpr uint8_t maxDirtyBlockShift = 8;
+
+        void resize(int32_t width, int32_t height, uint8_t blockWidthShift, uint8_t blockHeightShift);
         void drawDirtyBlocks();
         void drawRect(const ui::Rect& rect);
         void setDirtyBlocks(int32_t left, int32_t top, int32_t right, int32_t bottom);
 
     private:
+        int32_t _width = 0;
+        int32_t _height = 0;
+        uint8_t _blockWidthShift = 0;
+        uint8_t _blockHeightShift = 0;
+
+        // One bit per dirty block, each row of blocks padded to whole words
+        std::vector<uint64_t> _dirtyBlocks;
+        std::vector<uint64_t> _dirtyColumns;
+        size_t _dirtyBlockColumns = 0;
+        size_t _dirtyBlockRows = 0;
+        size_t _dirtyBlockWordsPerRow = 0;
+
+        uint64_t* getDirtyBlockRow(size_t y);
+        size_t getDirtyRun(size_t x, size_t y);
+        bool isDirtyRun(size_t x, size_t y, size_t dx);
+        void updateDirtyColumns();
         void drawDirtyBlocks(size_t x, size_t y, size_t dx, size_t dy);
     };
 }
@@ -27,6 +27,7 @@ namespace openloco::game_commands
         vehicle_pickup = 2,
         vehicle_create = 5,
         vehicle_sell = 6,
+        industry_remove = 48,
     };
 
     constexpr uint32_t FAILURE = 0x80000000;
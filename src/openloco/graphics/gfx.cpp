@@ -1,4 +1,5 @@
 #include "gfx.h"
+#include "../Benchmark.h"
 #include "../console.h"
 #include "../drawing/SoftwareDrawingEngine.h"
 #include "../environment.h"
@@ -12,9 +13,17 @@
 #include "image_ids.h"
 #include <algorithm>
 #include <cassert>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <list>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 using namespace openloco::interop;
 using namespace openloco::utility;
@@ -37,6 +46,20 @@ namespace openloco::gfx
         constexpr uint8_t extra_dark = (1ULL << 3);
     }
 
+    namespace g1_element_flags
+    {
+        constexpr uint16_t has_transparency = (1 << 0); // Zero pixels are transparent
+        constexpr uint16_t rle_compression = (1 << 2);
+        constexpr uint16_t has_zoom_sprites = (1 << 4);
+        constexpr uint16_t no_zoom_draw = (1 << 5);
+    }
+
+    // Element flags the native blitter draws, elements with others are left to loco
+    constexpr uint16_t native_g1_element_flags = g1_element_flags::has_transparency | g1_element_flags::rle_compression | g1_element_flags::has_zoom_sprites | g1_element_flags::no_zoom_draw;
+
+    // Image id bits selecting remaps and translucency, which only loco draws
+    constexpr uint32_t image_id_flags = 0xE0000000;
+
     constexpr uint32_t g1_count_objects = 0x40000;
     constexpr uint32_t g1_count_temporary = 0x1000;
 
@@ -54,6 +77,31 @@ namespace openloco::gfx
 
     static palette_index_t _textColours[8] = { 0 };
 
+    // Runs of glyphs drawn recently, pre-rendered with their colours to run length encoded images
+    struct text_run
+    {
+        std::string key;
+        std::vector<uint8_t> data;
+        g1_element bitmap;
+        int16_t advance{};
+    };
+
+    constexpr size_t max_text_run_bytes = 1024 * 1024;
+
+    // Most recently drawn first
+    static std::list<std::unique_ptr<text_run>> _textRuns;
+    static std::unordered_map<std::string, std::list<std::unique_ptr<text_run>>::iterator> _textRunIndex;
+    static size_t _textRunBytes;
+
+    static bool draw_text_run(const drawpixelinfo_t& dpi, gfx::point_t& pos, const uint8_t* str, size_t length);
+
+    static void clear_text_runs()
+    {
+        _textRuns.clear();
+        _textRunIndex.clear();
+        _textRunBytes = 0;
+    }
+
     drawpixelinfo_t& screen_dpi()
     {
         return _screen_dpi;
@@ -136,6 +184,7 @@ namespace openloco::gfx
 
         _g1Buffer = std::move(elementData);
         std::copy(elements.begin(), elements.end(), _g1Elements.get());
+        clear_text_runs();
     }
 
     g1_element* get_g1_element(uint32_t image)
@@ -286,6 +335,12 @@ namespace openloco::gfx
         setTextColours(el->offset[colour * 4 + 0], el->offset[colour * 4 + 1], el->offset[colour * 4 + 2]);
     }
 
+    // Characters drawn as glyphs by loop_newline, rather than handled as control codes
+    static bool is_glyph(uint8_t chr)
+    {
+        return chr >= 32 && (chr < control_codes::colour_black || chr > control_codes::colour_palesilver);
+    }
+
     // 0x00451189
     static gfx::point_t loop_newline(drawpixelinfo_t* context, gfx::point_t origin, uint8_t* str)
     {
@@ -489,6 +544,19 @@ namespace openloco::gfx
                         // When offscreen in the y dimension there is no requirement to keep pos.x correct
                         if (chr >= 32)
                         {
+                            // Draw the glyphs up to the next control code at once when possible
+                            size_t length = 1;
+                            while (is_glyph(str[length - 1]))
+                            {
+                                length++;
+                            }
+
+                            if (length > 1 && draw_text_run(*context, pos, str - 1, length))
+                            {
+                                str += length - 1;
+                                break;
+                            }
+
                             gfx::draw_image_palette_set(context, pos.x, pos.y, 1116 + chr - 32 + _currentFontSpriteBase, _textColours);
                             pos.x += _characterWidths[chr - 32 + _currentFontSpriteBase];
                         }
@@ -990,6 +1058,14 @@ namespace openloco::gfx
 
     drawing::SoftwareDrawingEngine* engine;
 
+    void resize_dirty_blocks(int32_t width, int32_t height, uint8_t blockWidthShift, uint8_t blockHeightShift)
+    {
+        if (engine == nullptr)
+            engine = new drawing::SoftwareDrawingEngine();
+
+        engine->resize(width, height, blockWidthShift, blockHeightShift);
+    }
+
     /**
      * 0x004C5C69
      *
@@ -1072,8 +1148,350 @@ namespace openloco::gfx
         redraw_screen_rect(Rect::fromLTRB(left, top, right, bottom));
     }
 
+    // Part of an image visible within a drawpixelinfo
+    struct image_clip
+    {
+        int32_t srcX;
+        int32_t srcY;
+        int32_t width;
+        int32_t height;
+        uint8_t* dst;
+        int32_t dstStride;
+    };
+
+    static bool clip_image(const drawpixelinfo_t& dpi, const g1_element& element, int16_t x, int16_t y, image_clip& clip)
+    {
+        const int32_t left = x + element.x_offset - dpi.x;
+        const int32_t top = y + element.y_offset - dpi.y;
+        const int32_t right = std::min<int32_t>(left + element.width, dpi.width);
+        const int32_t bottom = std::min<int32_t>(top + element.height, dpi.height);
+        const int32_t dstX = std::max(left, 0);
+        const int32_t dstY = std::max(top, 0);
+
+        clip.srcX = dstX - left;
+        clip.srcY = dstY - top;
+        clip.width = right - dstX;
+        clip.height = bottom - dstY;
+        clip.dstStride = dpi.width + dpi.pitch;
+        clip.dst = dpi.bits + dstY * clip.dstStride + dstX;
+        return clip.width > 0 && clip.height > 0;
+    }
+
+    // Copies a run of pixels, through the palette when one is given, where mapping to zero leaves the pixel untouched
+    static void draw_run(uint8_t* dst, const uint8_t* src, int32_t length, const uint8_t* palette)
+    {
+        if (palette == nullptr)
+        {
+            std::memcpy(dst, src, length);
+            return;
+        }
+
+        for (int32_t i = 0; i < length; i++)
+        {
+            auto colour = palette[src[i]];
+            if (colour != 0)
+            {
+                dst[i] = colour;
+            }
+        }
+    }
+
+    // Draws an uncompressed image, row after row of width pixels
+    static void draw_bitmap(const g1_element& element, const image_clip& clip, const uint8_t* palette)
+    {
+        const bool hasTransparency = (element.flags & g1_element_flags::has_transparency) != 0;
+        const uint8_t* src = element.offset + clip.srcY * element.width + clip.srcX;
+        uint8_t* dst = clip.dst;
+        for (int32_t y = 0; y < clip.height; y++)
+        {
+            if (!hasTransparency)
+            {
+                draw_run(dst, src, clip.width, palette);
+            }
+            else
+            {
+                for (int32_t x = 0; x < clip.width; x++)
+                {
+                    if (src[x] != 0)
+                    {
+                        draw_run(dst + x, src + x, 1, palette);
+                    }
+                }
+            }
+            src += element.width;
+            dst += clip.dstStride;
+        }
+    }
+
+    // Draws a run length encoded image. It starts with the offset of each row, and each row is a list of
+    // runs of opaque pixels: the length, with the top bit set on the last run, the start column and the pixels.
+    static void draw_rle(const g1_element& element, const image_clip& clip, const uint8_t* palette)
+    {
+        const auto rowOffsets = reinterpret_cast<const uint16_t*>(element.offset);
+        const int32_t clipRight = clip.srcX + clip.width;
+        uint8_t* dstRow = clip.dst - clip.srcX;
+        for (int32_t y = clip.srcY; y < clip.srcY + clip.height; y++)
+        {
+            const uint8_t* run = element.offset + rowOffsets[y];
+            bool isLastRun = false;
+            while (!isLastRun)
+            {
+                isLastRun = (run[0] & 0x80) != 0;
+                int32_t length = run[0] & 0x7F;
+                int32_t start = run[1];
+                const uint8_t* src = run + 2;
+                run = src + length;
+
+                // Clip the run to the visible columns
+                int32_t end = std::min(start + length, clipRight);
+                if (start < clip.srcX)
+                {
+                    src += clip.srcX - start;
+                    start = clip.srcX;
+                }
+                if (start < end)
+                {
+                    draw_run(dstRow + start, src, end - start, palette);
+                }
+            }
+            dstRow += clip.dstStride;
+        }
+    }
+
+    static void draw_element(const drawpixelinfo_t& dpi, const g1_element& element, int16_t x, int16_t y, const uint8_t* palette)
+    {
+        image_clip clip;
+        if (!clip_image(dpi, element, x, y, clip))
+        {
+            return;
+        }
+
+        if ((element.flags & g1_element_flags::rle_compression) != 0)
+        {
+            draw_rle(element, clip, palette);
+        }
+        else
+        {
+            draw_bitmap(element, clip, palette);
+        }
+    }
+
+    // Gets the element of an image the native blitter can draw, or nullptr if it is left to loco
+    static const g1_element* get_native_element(uint32_t image)
+    {
+        const uint32_t imageId = image & 0x7FFFF;
+        if ((image & image_id_flags) != 0 || imageId >= std::size(_g1Elements))
+        {
+            return nullptr;
+        }
+
+        // Empty elements, such as the space glyph, are clipped away before their pixels are read
+        const auto& element = _g1Elements[imageId];
+        const bool isEmpty = element.width <= 0 || element.height <= 0;
+        if ((element.flags & ~native_g1_element_flags) != 0 || (element.offset == nullptr && !isEmpty))
+        {
+            return nullptr;
+        }
+        return &element;
+    }
+
+    // Draws an image without remapping, or through a palette, at zoom level 0.
+    // Returns false for anything else, which is left to loco.
+    static bool draw_image_native(const drawpixelinfo_t& dpi, int16_t x, int16_t y, uint32_t image, const uint8_t* palette)
+    {
+        const auto element = get_native_element(image);
+        if (dpi.zoom_level != 0 || element == nullptr)
+        {
+            return false;
+        }
+
+        draw_element(dpi, *element, x, y, palette);
+        return true;
+    }
+
+    // The start column of each run is stored in a byte
+    constexpr int32_t max_rle_width = 256;
+
+    // Encodes a bitmap where zero is transparent in the format read by draw_rle, at most max_rle_width wide
+    static std::vector<uint8_t> encode_rle(const uint8_t* bitmap, int32_t width, int32_t height)
+    {
+        std::vector<uint8_t> data(height * sizeof(uint16_t));
+        for (int32_t y = 0; y < height; y++)
+        {
+            const auto rowOffset = static_cast<uint16_t>(data.size());
+            std::memcpy(data.data() + y * sizeof(uint16_t), &rowOffset, sizeof(rowOffset));
+
+            const uint8_t* row = bitmap + y * width;
+            size_t lastRun = data.size();
+            int32_t x = 0;
+            while (true)
+            {
+                while (x < width && row[x] == 0)
+                {
+                    x++;
+                }
+                if (x >= width)
+                {
+                    break;
+                }
+
+                const int32_t start = x;
+                while (x < width && row[x] != 0 && x - start < 0x7F)
+                {
+                    x++;
+                }
+                lastRun = data.size();
+                data.push_back(static_cast<uint8_t>(x - start));
+                data.push_back(static_cast<uint8_t>(start));
+                data.insert(data.end(), row + start, row + x);
+            }
+
+            if (lastRun == data.size())
+            {
+                // Empty row
+                data.push_back(0);
+                data.push_back(0);
+            }
+            data[lastRun] |= 0x80;
+        }
+        return data;
+    }
+
+    // Measures a run of glyphs and renders it to a bitmap, nullptr if loco has to draw any of them
+    static std::unique_ptr<text_run> render_text_run(const uint8_t* str, size_t length)
+    {
+        const int16_t fontSpriteBase = _currentFontSpriteBase;
+        int32_t left = std::numeric_limits<int32_t>::max();
+        int32_t top = std::numeric_limits<int32_t>::max();
+        int32_t right = std::numeric_limits<int32_t>::min();
+        int32_t bottom = std::numeric_limits<int32_t>::min();
+        int32_t x = 0;
+        for (size_t i = 0; i < length; i++)
+        {
+            const int32_t glyph = str[i] - 32 + fontSpriteBase;
+            const auto element = get_native_element(1116 + glyph);
+            if (element == nullptr)
+            {
+                return nullptr;
+            }
+
+            left = std::min<int32_t>(left, x + element->x_offset);
+            top = std::min<int32_t>(top, element->y_offset);
+            right = std::max<int32_t>(right, x + element->x_offset + element->width);
+            bottom = std::max<int32_t>(bottom, element->y_offset + element->height);
+            x += _characterWidths[glyph];
+        }
+
+        auto run = std::make_unique<text_run>();
+        run->advance = static_cast<int16_t>(x);
+        if (left >= right || top >= bottom)
+        {
+            return run;
+        }
+
+        const int32_t width = right - left;
+        const int32_t height = bottom - top;
+        std::vector<uint8_t> bitmap(width * height);
+
+        drawpixelinfo_t dpi{};
+        dpi.bits = bitmap.data();
+        dpi.x = static_cast<int16_t>(left);
+        dpi.y = static_cast<int16_t>(top);
+        dpi.width = static_cast<int16_t>(width);
+        dpi.height = static_cast<int16_t>(height);
+
+        x = 0;
+        for (size_t i = 0; i < length; i++)
+        {
+            const int32_t glyph = str[i] - 32 + fontSpriteBase;
+            draw_element(dpi, _g1Elements[1116 + glyph], x, 0, _textColours);
+            x += _characterWidths[glyph];
+        }
+
+        run->bitmap.width = static_cast<int16_t>(width);
+        run->bitmap.height = static_cast<int16_t>(height);
+        run->bitmap.x_offset = static_cast<int16_t>(left);
+        run->bitmap.y_offset = static_cast<int16_t>(top);
+        if (width <= max_rle_width)
+        {
+            run->data = encode_rle(bitmap.data(), width, height);
+        }
+        if (!run->data.empty() && run->data.size() <= std::numeric_limits<uint16_t>::max())
+        {
+            run->bitmap.flags = g1_element_flags::rle_compression;
+        }
+        else
+        {
+            // Too wide for the start columns or too large for the row offsets
+            run->data = std::move(bitmap);
+            run->bitmap.flags = g1_element_flags::has_transparency;
+        }
+        run->bitmap.offset = run->data.data();
+        return run;
+    }
+
+    // Draws a run of glyphs in the current font and colours from the cache, rendering it when missing.
+    // Returns false if loco has to draw the glyphs.
+    static bool draw_text_run(const drawpixelinfo_t& dpi, gfx::point_t& pos, const uint8_t* str, size_t length)
+    {
+        if (dpi.zoom_level != 0)
+        {
+            return false;
+        }
+
+        // The glyphs, font and colours
+        static std::string key;
+        const int16_t fontSpriteBase = _currentFontSpriteBase;
+        key.assign(reinterpret_cast<const char*>(str), length);
+        key.append(reinterpret_cast<const char*>(&fontSpriteBase), sizeof(fontSpriteBase));
+        key.append(reinterpret_cast<const char*>(_textColours), sizeof(_textColours));
+
+        const text_run* run = nullptr;
+        auto it = _textRunIndex.find(key);
+        if (it != _textRunIndex.end())
+        {
+            _textRuns.splice(_textRuns.begin(), _textRuns, it->second);
+            run = it->second->get();
+        }
+        else
+        {
+            auto newRun = render_text_run(str, length);
+            if (newRun == nullptr)
+            {
+                return false;
+            }
+
+            newRun->key = key;
+            _textRunBytes += newRun->data.size() + key.size();
+            _textRuns.push_front(std::move(newRun));
+            _textRunIndex[key] = _textRuns.begin();
+            run = _textRuns.front().get();
+
+            while (_textRunBytes > max_text_run_bytes && _textRuns.size() > 1)
+            {
+                auto& oldest = _textRuns.back();
+                _textRunBytes -= oldest->data.size() + oldest->key.size();
+                _textRunIndex.erase(oldest->key);
+                _textRuns.pop_back();
+            }
+        }
+
+        if (!run->data.empty())
+        {
+            draw_element(dpi, run->bitmap, pos.x, pos.y, nullptr);
+        }
+        pos.x += run->advance;
+        return true;
+    }
+
+    // 0x00448C79
     void draw_image(gfx::drawpixelinfo_t* dpi, int16_t x, int16_t y, uint32_t image)
     {
+        if (draw_image_native(*dpi, x, y, image, nullptr))
+        {
+            return;
+        }
+
         registers regs;
         regs.cx = x;
         regs.dx = y;
@@ -1104,8 +1522,14 @@ namespace openloco::gfx
         draw_image_palette_set(dpi, x, y, image, palette);
     }
 
+    // 0x00448D90
     void draw_image_palette_set(gfx::drawpixelinfo_t* dpi, int16_t x, int16_t y, uint32_t image, uint8_t* palette)
     {
+        if (draw_image_native(*dpi, x, y, image, palette))
+        {
+            return;
+        }
+
         _50B860 = palette;
         _E04324 = 0x20000000;
         registers regs;
@@ -1138,4 +1562,176 @@ namespace openloco::gfx
         }
         return nullptr;
     }
+
+    // Draws an image through loco's own blitter, without or with a palette, bypassing the native one
+    static void draw_image_loco(drawpixelinfo_t& dpi, int16_t x, int16_t y, uint32_t image, uint8_t* palette)
+    {
+        registers regs;
+        regs.cx = x;
+        regs.dx = y;
+        regs.ebx = image;
+        regs.edi = (uint32_t)&dpi;
+        if (palette == nullptr)
+        {
+            call(0x00448C79, regs);
+            return;
+        }
+
+        _50B860 = palette;
+        _E04324 = 0x20000000;
+        call(0x00448D90, regs);
+    }
+
+    // Draws the glyphs of a string one by one through loco, as loop_newline does when it cannot use a run
+    static void draw_glyphs_loco(drawpixelinfo_t& dpi, int16_t x, int16_t y, const std::string& text)
+    {
+        for (auto chr : text)
+        {
+            const int32_t glyph = static_cast<uint8_t>(chr) - 32 + _currentFontSpriteBase;
+            draw_image_loco(dpi, x, y, 1116 + glyph, _textColours);
+            x += _characterWidths[glyph];
+        }
+    }
+
+    // Checks that every image the native blitter draws comes out the same as from loco's 0x00448C79 and, through
+    // a palette that maps some colours to zero, 0x00448D90. Each image is drawn whole and clipped on every side.
+    bool benchmark_images()
+    {
+        constexpr int16_t margin = 8;
+        uint8_t palette[256];
+        for (int32_t i = 0; i < 256; i++)
+        {
+            palette[i] = i % 7 == 0 ? 0 : static_cast<uint8_t>(i * 37 + 11);
+        }
+
+        std::vector<uint32_t> images;
+        for (uint32_t image = 0; image < std::size(_g1Elements); image++)
+        {
+            const auto element = get_native_element(image);
+            if (element != nullptr && element->offset != nullptr && element->width > 0 && element->height > 0)
+            {
+                images.push_back(image);
+            }
+        }
+        console::log("  %u images drawn natively", static_cast<uint32_t>(images.size()));
+
+        std::vector<uint8_t> expected;
+        std::vector<uint8_t> actual;
+        uint32_t mismatches = 0;
+        for (auto image : images)
+        {
+            const auto& element = _g1Elements[image];
+            const int16_t width = element.width + margin * 2;
+            const int16_t height = element.height + margin * 2;
+            expected.resize(width * height);
+            actual.resize(width * height);
+            drawpixelinfo_t expectedDpi{ expected.data(), 0, 0, width, height, 0, 0 };
+            drawpixelinfo_t actualDpi{ actual.data(), 0, 0, width, height, 0, 0 };
+
+            const int16_t x = margin - element.x_offset;
+            const int16_t y = margin - element.y_offset;
+            const int16_t clipX = element.width / 2 + margin;
+            const int16_t clipY = element.height / 2 + margin;
+            const std::pair<int16_t, int16_t> positions[] = {
+                { x, y },
+                { x - clipX, y - clipY },
+                { x + clipX, y + clipY },
+            };
+            for (auto imagePalette : { static_cast<uint8_t*>(nullptr), palette })
+            {
+                for (const auto& [imageX, imageY] : positions)
+                {
+                    std::fill(expected.begin(), expected.end(), 0x55);
+                    std::fill(actual.begin(), actual.end(), 0x55);
+                    draw_image_loco(expectedDpi, imageX, imageY, image, imagePalette);
+                    draw_image_native(actualDpi, imageX, imageY, image, imagePalette);
+                    if (expected != actual)
+                    {
+                        if (mismatches < 20)
+                        {
+                            console::error("  image %u at %d, %d%s differs", image, imageX, imageY, imagePalette != nullptr ? " with palette" : "");
+                        }
+                        mismatches++;
+                    }
+                }
+            }
+        }
+        if (mismatches != 0)
+        {
+            console::error("  %u draws differ", mismatches);
+        }
+
+        std::vector<uint8_t> screen(1024 * 1024);
+        drawpixelinfo_t dpi{ screen.data(), 0, 0, 1024, 1024, 0, 0 };
+        const auto numImages = static_cast<uint32_t>(images.size());
+        benchmark::measure("image, loco", numImages, [&](uint32_t i) { draw_image_loco(dpi, 512, 512, images[i], nullptr); });
+        benchmark::measure("image, native", numImages, [&](uint32_t i) { draw_image_native(dpi, 512, 512, images[i], nullptr); });
+        benchmark::measure("image with palette, loco", numImages, [&](uint32_t i) { draw_image_loco(dpi, 512, 512, images[i], palette); });
+        benchmark::measure("image with palette, native", numImages, [&](uint32_t i) { draw_image_native(dpi, 512, 512, images[i], palette); });
+        return mismatches == 0;
+    }
+
+    // Checks that runs of glyphs, including runs wider than the columns a run length encoded row can address,
+    // draw from the cache the same as their glyphs drawn one by one by loco.
+    bool benchmark_text_runs()
+    {
+        std::string printable;
+        for (char chr = 33; chr < 127; chr++)
+        {
+            printable.push_back(chr);
+        }
+        const std::string texts[] = { "Locomotion", printable, printable + printable };
+
+        constexpr int16_t width = 2048;
+        constexpr int16_t height = 32;
+        std::vector<uint8_t> expected(width * height);
+        std::vector<uint8_t> actual(width * height);
+        drawpixelinfo_t expectedDpi{ expected.data(), 0, 0, width, height, 0, 0 };
+        drawpixelinfo_t actualDpi{ actual.data(), 0, 0, width, height, 0, 0 };
+
+        const int16_t fontSpriteBase = _currentFontSpriteBase;
+        palette_index_t textColours[std::size(_textColours)];
+        std::copy(std::begin(_textColours), std::end(_textColours), textColours);
+        _currentFontSpriteBase = font::medium_normal;
+        // As with an outline, so that every colour of the glyphs is drawn
+        _textColours[1] = palette_index::index_0A;
+        _textColours[2] = palette_index::index_30;
+        _textColours[3] = palette_index::index_64;
+
+        bool passed = true;
+        for (const auto& text : texts)
+        {
+            auto run = render_text_run(reinterpret_cast<const uint8_t*>(text.data()), text.size());
+            if (run == nullptr)
+            {
+                console::error("  '%s' could not be rendered natively", text.c_str());
+                passed = false;
+                continue;
+            }
+
+            // Draw clipped on the left and right as well, which skips some of the columns of each row
+            for (int16_t x : { 4, -100, width - 300 })
+            {
+                std::fill(expected.begin(), expected.end(), 0x55);
+                std::fill(actual.begin(), actual.end(), 0x55);
+                draw_glyphs_loco(expectedDpi, x, 8, text);
+                draw_element(actualDpi, run->bitmap, x, 8, nullptr);
+                if (expected != actual)
+                {
+                    console::error("  %u px wide run of %u glyphs at x %d differs", run->bitmap.width, static_cast<uint32_t>(text.size()), x);
+                    passed = false;
+                }
+            }
+
+            char name[64];
+            std::snprintf(name, sizeof(name), "%u px run, glyphs through loco", run->bitmap.width);
+            benchmark::measure(name, 1000, [&](uint32_t) { draw_glyphs_loco(expectedDpi, 4, 8, text); });
+            std::snprintf(name, sizeof(name), "%u px run, cached", run->bitmap.width);
+            benchmark::measure(name, 1000, [&](uint32_t) { draw_element(actualDpi, run->bitmap, 4, 8, nullptr); });
+        }
+
+        _currentFontSpriteBase = fontSpriteBase;
+        std::copy(std::begin(textColours), std::end(textColours), _textColours);
+        return passed;
+    }
 }
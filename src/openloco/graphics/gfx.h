@@ -172,6 +172,7 @@ namespace openloco::gfx
     uint32_t recolour(uint32_t image, uint8_t colour);
 
     void invalidate_screen();
+    void resize_dirty_blocks(int32_t width, int32_t height, uint8_t blockWidthShift, uint8_t blockHeightShift);
     void set_dirty_blocks(int32_t left, int32_t top, int32_t right, int32_t bottom);
     void draw_dirty_blocks();
     void render();
@@ -181,4 +182,7 @@ namespace openloco::gfx
 
     bool clip_drawpixelinfo(gfx::drawpixelinfo_t** dst, gfx::drawpixelinfo_t* src, int16_t x, int16_t y, int16_t width, int16_t height);
     g1_element* get_g1element(uint32_t id);
+
+    bool benchmark_images();
+    bool benchmark_text_runs();
 }
@@ -1,4 +1,5 @@
 #include "industry.h"
+#include "industrymgr.h"
 #include "interop/interop.hpp"
 #include "localisation/string_ids.h"
 #include "map/tilemgr.h"
@@ -118,17 +119,28 @@ namespace openloco
     {
         if (!(flags & industry_flags::flag_01) && under_construction == 0xFF)
         {
-            // Run tile loop for 100 iterations
-            for (int i = 0; i < 100; i++)
+            // Run tile loop for 100 iterations. Only tiles owned by this industry have any
+            // effect in sub_45329B, so visit just those within the range instead.
+            constexpr uint32_t numIterations = 100;
+            const auto start = tile_loop.index();
+            const auto end = std::min<uint32_t>(start + numIterations, map_size);
+
+            const auto& ownedTiles = industrymgr::getOwnedTiles(id());
+            for (auto it = std::lower_bound(ownedTiles.begin(), ownedTiles.end(), start); it != ownedTiles.end() && *it < end; it++)
             {
-                sub_45329B(tile_loop.current());
+                sub_45329B(tile_loop::from_index(*it));
+            }
 
-                // loc_453318
-                if (tile_loop.next() == map_pos())
-                {
-                    sub_453354();
-                    break;
-                }
+            // loc_453318
+            if (end == map_size)
+            {
+                tile_loop.set_index(0);
+                industrymgr::pruneOwnedTiles(id());
+                sub_453354();
+            }
+            else
+            {
+                tile_loop.set_index(end);
             }
         }
     }
@@ -212,5 +224,8 @@ namespace openloco
         regs.dl = dl;
         regs.dh = id();
         call(0x00454A43, regs);
+
+        // The extent of the grounds grown by loco is not known, so the index is rebuilt
+        industrymgr::invalidateOwnedTiles(id());
     }
 }
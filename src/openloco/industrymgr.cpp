@@ -1,14 +1,35 @@
 #include "industrymgr.h"
 #include "companymgr.h"
 #include "interop/interop.hpp"
+#include "map/tilemgr.h"
 #include "openloco.h"
+#include <algorithm>
 
 using namespace openloco::interop;
+using namespace openloco::map;
 
 namespace openloco::industrymgr
 {
     static loco_global<industry[max_industries], 0x005C455C> _industries;
 
+    // Surface tiles owned (farmed) by each industry as sorted tile loop indices, so that
+    // industry::update does not have to walk the whole map to find them. Entries are
+    // verified when visited, so tiles that have since lost their owner only cost time
+    // until they are pruned at the end of the industry's tile loop.
+    struct OwnedTiles
+    {
+        std::vector<uint32_t> tiles;
+        bool valid = false;
+
+        // The industry the index was built for, a mismatch means the slot has been reused
+        string_id name;
+        coord_t x;
+        coord_t y;
+        uint8_t objectId;
+    };
+
+    static std::array<OwnedTiles, max_industries> _ownedTiles;
+
     std::array<industry, max_industries>& industries()
     {
         auto arr = (std::array<industry, max_industries>*)_industries.get();
@@ -44,5 +65,97 @@ namespace openloco::industrymgr
     void update_monthly()
     {
         call(0x0045383B);
+
+        // Industries may have been created, closed or expanded their grounds
+        invalidateOwnedTiles();
+    }
+
+    static bool isOwnedBy(const surface_element* surface, industry_id_t id)
+    {
+        return surface != nullptr && surface->has_high_type_flag() && surface->industry_id() == id;
+    }
+
+    static bool matchesIndustry(const OwnedTiles& entry, const industry& ind)
+    {
+        return entry.name == ind.name && entry.x == ind.x && entry.y == ind.y && entry.objectId == ind.object_id;
+    }
+
+    static void resetOwnedTiles(OwnedTiles& entry, const industry& ind)
+    {
+        entry.tiles.clear();
+        entry.valid = true;
+        entry.name = ind.name;
+        entry.x = ind.x;
+        entry.y = ind.y;
+        entry.objectId = ind.object_id;
+    }
+
+    // Rebuilds the index of every industry that needs it with a single pass over the map.
+    static void rebuildOwnedTiles()
+    {
+        std::array<bool, max_industries> rebuild{};
+        for (auto& ind : industries())
+        {
+            auto& entry = _ownedTiles[ind.id()];
+            if (!ind.empty() && (!entry.valid || !matchesIndustry(entry, ind)))
+            {
+                resetOwnedTiles(entry, ind);
+                rebuild[ind.id()] = true;
+            }
+        }
+
+        for (uint32_t index = 0; index < static_cast<uint32_t>(map_size); index++)
+        {
+            auto surface = tilemgr::get(tile_loop::from_index(index)).surface();
+            if (surface != nullptr && surface->has_high_type_flag())
+            {
+                auto id = surface->industry_id();
+                if (id < max_industries && rebuild[id])
+                {
+                    _ownedTiles[id].tiles.push_back(index);
+                }
+            }
+        }
+    }
+
+    const std::vector<uint32_t>& getOwnedTiles(industry_id_t id)
+    {
+        auto& entry = _ownedTiles[id];
+        if (!entry.valid || !matchesIndustry(entry, *get(id)))
+        {
+            rebuildOwnedTiles();
+        }
+        return entry.tiles;
+    }
+
+    // Drops tiles that are no longer owned by the industry.
+    void pruneOwnedTiles(industry_id_t id)
+    {
+        auto& tiles = _ownedTiles[id].tiles;
+        tiles.erase(
+            std::remove_if(tiles.begin(), tiles.end(), [id](uint32_t index) {
+                return !isOwnedBy(tilemgr::get(tile_loop::from_index(index)).surface(), id);
+            }),
+            tiles.end());
+    }
+
+    // Must be called whenever loco code may have given the industry more tiles, e.g. after it grew
+    // its grounds, and when the industry is removed.
+    void invalidateOwnedTiles(industry_id_t id)
+    {
+        if (id < max_industries)
+        {
+            _ownedTiles[id].valid = false;
+        }
+    }
+
+    // Must be called whenever loco code may have changed the owner of tiles of any industry, e.g.
+    // after the monthly industry update, and whenever the map is replaced.
+    void invalidateOwnedTiles()
+    {
+        for (auto& entry : _ownedTiles)
+        {
+            entry.valid = false;
+        }
     }
 }
@@ -3,6 +3,7 @@
 #include "industry.h"
 #include <array>
 #include <cstddef>
+#include <vector>
 
 namespace openloco::industrymgr
 {
@@ -12,4 +13,9 @@ namespace openloco::industrymgr
     industry* get(industry_id_t id);
     void update();
     void update_monthly();
+
+    const std::vector<uint32_t>& getOwnedTiles(industry_id_t id);
+    void pruneOwnedTiles(industry_id_t id);
+    void invalidateOwnedTiles(industry_id_t id);
+    void invalidateOwnedTiles();
 }
@@ -6,6 +6,7 @@
 #include <sys/mman.h>
 #include <unistd.h>
 #endif
+#include "../Replay.h"
 #include "../Title.h"
 #include "../audio/audio.h"
 #include "../console.h"
@@ -15,10 +16,13 @@
 #include "../graphics/colours.h"
 #include "../graphics/gfx.h"
 #include "../gui.h"
+#include "../industrymgr.h"
 #include "../input.h"
 #include "../map/tile.h"
+#include "../map/tilemgr.h"
 #include "../platform/platform.h"
 #include "../station.h"
+#include "../things/thingmgr.h"
 #include "../things/vehicle.h"
 #include "../tutorial.h"
 #include "../ui.h"
@@ -725,6 +729,12 @@ void openloco::interop::register_hooks()
     register_hook(
         0x00438A6C,
         [](registers& regs) FORCE_ALIGN_ARG_POINTER -> uint8_t {
+            // Called whenever a game is loaded or a new one is started
+            static loco_global<char[512], 0x0112CE04> savePath;
+            openloco::map::tilemgr::compact_elements();
+            industrymgr::invalidateOwnedTiles();
+            thingmgr::invalidateVehicleIndex();
+            replay::onGameLoaded(fs::u8path(&*savePath));
             gui::init();
             return 0;
         });
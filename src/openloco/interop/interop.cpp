@@ -1,7 +1,10 @@
 #include <algorithm>
+#include <chrono>
 #include <cinttypes>
 #include <cstring>
 #include <stdexcept>
+#include <unordered_map>
+#include <vector>
 
 #ifdef _WIN32
 #ifndef NOMINMAX
@@ -280,9 +283,24 @@ namespace openloco::interop
         return call(address, regs);
     }
 
+#ifdef _PROFILE_INTEROP_CALLS_
+    struct CallProfile
+    {
+        uint64_t count{};
+        std::chrono::steady_clock::duration time{};
+    };
+
+    static std::unordered_map<int32_t, CallProfile> _callProfiles;
+#endif
+
     int32_t call(int32_t address, registers& registers)
     {
-        return call_byref(
+#ifdef _PROFILE_INTEROP_CALLS_
+        // Time of nested calls is included in the caller. Calls that never return, e.g. ending a tick early
+        // with longjmp, are not recorded.
+        auto start = std::chrono::steady_clock::now();
+#endif
+        auto result = call_byref(
             address,
             &registers.eax,
             &registers.ebx,
@@ -291,6 +309,50 @@ namespace openloco::interop
             &registers.esi,
             &registers.edi,
             &registers.ebp);
+#ifdef _PROFILE_INTEROP_CALLS_
+        auto& profile = _callProfiles[address];
+        profile.count++;
+        profile.time += std::chrono::steady_clock::now() - start;
+#endif
+        return result;
+    }
+
+    bool is_call_profile_enabled()
+    {
+#ifdef _PROFILE_INTEROP_CALLS_
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // Logs every called address sorted by inclusive time, most expensive first
+    void print_call_profile()
+    {
+#ifdef _PROFILE_INTEROP_CALLS_
+        using ms = std::chrono::duration<double, std::milli>;
+
+        std::vector<std::pair<int32_t, CallProfile>> profiles(_callProfiles.begin(), _callProfiles.end());
+        std::sort(profiles.begin(), profiles.end(), [](const auto& a, const auto& b) {
+            return a.second.time > b.second.time;
+        });
+
+        openloco::console::log("%-10s %12s %14s %12s", "Address", "Calls", "Total (ms)", "Avg (us)");
+        for (const auto& [address, profile] : profiles)
+        {
+            auto totalMs = ms(profile.time).count();
+            openloco::console::log("0x%08X %12" PRIu64 " %14.3f %12.3f", address, profile.count, totalMs, totalMs * 1000.0 / profile.count);
+        }
+#else
+        openloco::console::log("Interop call profiling is not enabled in this build");
+#endif
+    }
+
+    void reset_call_profile()
+    {
+#ifdef _PROFILE_INTEROP_CALLS_
+        _callProfiles.clear();
+#endif
     }
 
     void read_memory(uint32_t address, void* data, size_t size)
@@ -122,6 +122,11 @@ namespace openloco::interop
     int32_t call(int32_t address);
     int32_t call(int32_t address, registers& registers);
 
+    // Call count and inclusive time per address, only recorded when built with _PROFILE_INTEROP_CALLS_
+    bool is_call_profile_enabled();
+    void print_call_profile();
+    void reset_call_profile();
+
     template<typename T, uintptr_t TAddress>
     struct loco_global
     {
@@ -1341,4 +1341,20 @@ namespace openloco::string_ids
 
     constexpr string_id disableAICompanies = 2141;
     constexpr string_id disableAICompanies_tip = 2142;
+
+    constexpr string_id tooltip_speed_native_fast_forward = 2143;
+    constexpr string_id native_fast_forward_off = 2144;
+    constexpr string_id native_fast_forward_x4 = 2145;
+    constexpr string_id native_fast_forward_x16 = 2146;
+    constexpr string_id native_fast_forward_max = 2147;
+
+    constexpr string_id menu_tick_profiler = 2148;
+    constexpr string_id menu_print_reset_interop_call_profile = 2149;
+
+    constexpr string_id tick_profiler_stage_ms = 2150;
+    constexpr string_id tick_profiler_average = 2151;
+    constexpr string_id tick_profiler_minimum = 2152;
+    constexpr string_id tick_profiler_maximum = 2153;
+    constexpr string_id tick_profiler_p99 = 2154;
+    constexpr string_id tick_profiler_recording = 2155;
 }
@@ -11,7 +11,13 @@ namespace openloco::map
         map_pos _pos;
 
     public:
+        // Row-major tile index of a position, i.e. the order in which the loop visits tiles
+        static constexpr uint32_t to_index(const map_pos& pos) { return (pos.y / tile_size) * map_columns + (pos.x / tile_size); }
+        static map_pos from_index(uint32_t index) { return map_pos((index % map_columns) * tile_size, (index / map_columns) * tile_size); }
+
         map_pos current() const { return _pos; }
+        uint32_t index() const { return to_index(_pos); }
+        void set_index(uint32_t index) { _pos = from_index(index); }
         map_pos next()
         {
             _pos.x += tile_size;
@@ -1,13 +1,20 @@
 #include "tilemgr.h"
+#include "../Benchmark.h"
+#include "../console.h"
 #include "../input.h"
 #include "../interop/interop.hpp"
 #include "../viewportmgr.h"
+#include <algorithm>
+#include <array>
+#include <vector>
 
 using namespace openloco::interop;
 
 namespace openloco::map::tilemgr
 {
     static loco_global<tile_element* [0x30004], 0x00E40134> _tiles;
+    // Rows of _tiles are wider than the map, the remaining entries are unused
+    constexpr size_t tiles_row_stride = 512;
     static loco_global<coord_t, 0x00F24486> _mapSelectionAX;
     static loco_global<coord_t, 0x00F24488> _mapSelectionBX;
     static loco_global<coord_t, 0x00F2448A> _mapSelectionAY;
@@ -35,6 +42,286 @@ namespace openloco::map::tilemgr
         return tile(tileX, tileY, data);
     }
 
+    static tile_element* get_tile_elements(size_t index)
+    {
+        auto data = _tiles[index];
+        if (data == (tile_element*)0xFFFFFFFF)
+        {
+            data = nullptr;
+        }
+        return data;
+    }
+
+    static tile_element* get_tile_elements(tile_coord_t tx, tile_coord_t ty)
+    {
+        return get_tile_elements(ty * tiles_row_stride + tx);
+    }
+
+    // Measures how far the tile elements are from being stored contiguously in row-major tile order.
+    element_storage_stats get_element_storage_stats()
+    {
+        element_storage_stats stats{};
+        const tile_element* first = nullptr;
+        const tile_element* last = nullptr;
+        const tile_element* expected = nullptr;
+        for (tile_coord_t ty = 0; ty < map_rows; ty++)
+        {
+            for (tile_coord_t tx = 0; tx < map_columns; tx++)
+            {
+                auto t = tile(tx, ty, get_tile_elements(tx, ty));
+                if (t.is_null())
+                {
+                    continue;
+                }
+
+                auto begin = t.begin();
+                auto end = t.end();
+                if (expected != nullptr && begin != expected)
+                {
+                    stats.out_of_order_tiles++;
+                }
+                stats.elements += static_cast<uint32_t>(end - begin);
+                first = first == nullptr ? begin : std::min<const tile_element*>(first, begin);
+                last = std::max<const tile_element*>(last, end);
+                expected = end;
+            }
+        }
+        stats.span = static_cast<uint32_t>(last - first);
+        return stats;
+    }
+
+    // Rewrites the elements of every tile contiguously in row-major tile order so that scans over
+    // neighbouring tiles read neighbouring memory. The elements are packed at the start of the range
+    // they already occupy, so the element buffer and loco's end of buffer pointer are left alone and
+    // the freed elements past the packed range are only reclaimed once loco reorganises the buffer.
+    // Must only be called while nothing holds pointers to elements, such as straight after loading.
+    void compact_elements()
+    {
+        auto before = get_element_storage_stats();
+        if (before.elements == 0 || before.out_of_order_tiles == 0)
+        {
+            return;
+        }
+
+        std::vector<tile_element> packed;
+        packed.reserve(before.elements);
+        std::vector<uint32_t> offsets(map_size);
+        tile_element* first = nullptr;
+        tile_element* last = nullptr;
+        for (tile_coord_t ty = 0; ty < map_rows; ty++)
+        {
+            for (tile_coord_t tx = 0; tx < map_columns; tx++)
+            {
+                auto t = tile(tx, ty, get_tile_elements(tx, ty));
+                if (t.is_null())
+                {
+                    continue;
+                }
+
+                offsets[ty * map_columns + tx] = static_cast<uint32_t>(packed.size());
+                packed.insert(packed.end(), t.begin(), t.end());
+                first = first == nullptr ? t.begin() : std::min(first, t.begin());
+                last = std::max(last, t.end());
+            }
+        }
+
+        // Entries outside the map should never point at elements, which would be overwritten
+        for (size_t index = 0; index < std::size(_tiles); index++)
+        {
+            if (index % tiles_row_stride < (size_t)map_columns && index / tiles_row_stride < (size_t)map_rows)
+            {
+                continue;
+            }
+
+            auto data = get_tile_elements(index);
+            if (data != nullptr && data >= first && data < last)
+            {
+                console::error("Unable to compact tile elements, entry %u is outside the map", static_cast<uint32_t>(index));
+                return;
+            }
+        }
+
+        std::copy(packed.begin(), packed.end(), first);
+        for (tile_coord_t ty = 0; ty < map_rows; ty++)
+        {
+            for (tile_coord_t tx = 0; tx < map_columns; tx++)
+            {
+                auto index = ty * tiles_row_stride + tx;
+                if (get_tile_elements(index) != nullptr)
+                {
+                    _tiles[index] = first + offsets[ty * map_columns + tx];
+                }
+            }
+        }
+
+        auto after = get_element_storage_stats();
+        console::log(
+            "Compacted %u tile elements, %u tiles were out of order, span reduced from %u to %u elements",
+            after.elements,
+            before.out_of_order_tiles,
+            before.span,
+            after.span);
+    }
+
+    // Height of a sloped surface above its base at a position within the tile, given as subtile coordinates
+    static int16_t get_slope_height(uint8_t slope, bool isDoubleHeight, int xl, int yl)
+    {
+        int16_t height = 0;
+        int8_t quad = 0, quad_extra = 0; // which quadrant the element is in?
+                                         // quad_extra is for extra height tiles
+
+        uint8_t TILE_SIZE = 31;
+
+        // Slope logic:
+        // Each of the four bits in slope represents that corner being raised
+        // slope == 15 (all four bits) is not used and slope == 0 is flat
+        // If the extra_height bit is set, then the slope goes up two z-levels
+
+        // We arbitrarily take the SW corner to be closest to the viewer
+
+        // One corner up
+        if (slope == surface_slope::n_corner_up || slope == surface_slope::e_corner_up || slope == surface_slope::s_corner_up || slope == surface_slope::w_corner_up)
+        {
+            switch (slope)
+            {
+                case surface_slope::n_corner_up:
+                    quad = xl + yl - TILE_SIZE;
+                    break;
+                case surface_slope::e_corner_up:
+                    quad = xl - yl;
+                    break;
+                case surface_slope::s_corner_up:
+                    quad = TILE_SIZE - yl - xl;
+                    break;
+                case surface_slope::w_corner_up:
+                    quad = yl - xl;
+                    break;
+            }
+            // If the element is in the quadrant with the slope, raise its height
+            if (quad > 0)
+            {
+                height += quad / 2;
+            }
+        }
+
+        // One side up
+        switch (slope)
+        {
+            case surface_slope::ne_side_up:
+                height += xl / 2 + 1;
+                break;
+            case surface_slope::se_side_up:
+                height += (TILE_SIZE - yl) / 2;
+                break;
+            case surface_slope::nw_side_up:
+                height += yl / 2;
+                height++;
+                break;
+            case surface_slope::sw_side_up:
+                height += (TILE_SIZE - xl) / 2;
+                break;
+        }
+
+        // One corner down
+        if ((slope == surface_slope::w_corner_dn) || (slope == surface_slope::s_corner_dn) || (slope == surface_slope::e_corner_dn) || (slope == surface_slope::n_corner_dn))
+        {
+            switch (slope)
+            {
+                case surface_slope::w_corner_dn:
+                    quad_extra = xl + TILE_SIZE - yl;
+                    quad = xl - yl;
+                    break;
+                case surface_slope::s_corner_dn:
+                    quad_extra = xl + yl;
+                    quad = xl + yl - TILE_SIZE - 1;
+                    break;
+                case surface_slope::e_corner_dn:
+                    quad_extra = TILE_SIZE - xl + yl;
+                    quad = yl - xl;
+                    break;
+                case surface_slope::n_corner_dn:
+                    quad_extra = (TILE_SIZE - xl) + (TILE_SIZE - yl);
+                    quad = TILE_SIZE - yl - xl - 1;
+                    break;
+            }
+
+            if (isDoubleHeight)
+            {
+                height += quad_extra / 2;
+                height++;
+                return height;
+            }
+            // This tile is essentially at the next height level
+            height += 0x10;
+            // so we move *down* the slope
+            if (quad < 0)
+            {
+                height += quad / 2;
+            }
+        }
+
+        // Valleys
+        if ((slope == surface_slope::w_e_valley) || (slope == surface_slope::n_s_valley))
+        {
+            switch (slope)
+            {
+                case surface_slope::w_e_valley:
+                    if (xl + yl <= TILE_SIZE + 1)
+                    {
+                        return height;
+                    }
+                    quad = TILE_SIZE - xl - yl;
+                    break;
+                case surface_slope::n_s_valley:
+                    quad = xl - yl;
+                    break;
+            }
+            if (quad > 0)
+            {
+                height += quad / 2;
+            }
+        }
+
+        return height;
+    }
+
+    // Height above the base of a surface for every slope and subtile position, indexed by
+    // surface_element::slope() and then by yl * tile_size + xl
+    using slope_height_table = std::array<std::array<int8_t, tile_size * tile_size>, 32>;
+
+    static slope_height_table build_slope_heights()
+    {
+        slope_height_table table;
+        for (uint8_t slope = 0; slope < table.size(); slope++)
+        {
+            for (int yl = 0; yl < tile_size; yl++)
+            {
+                for (int xl = 0; xl < tile_size; xl++)
+                {
+                    auto corners = slope & surface_slope::all_corners_up;
+                    auto isDoubleHeight = (slope & surface_slope::double_height) != 0;
+                    table[slope][yl * tile_size + xl] = static_cast<int8_t>(get_slope_height(corners, isDoubleHeight, xl, yl));
+                }
+            }
+        }
+        return table;
+    }
+
+    static const slope_height_table _slopeHeights = build_slope_heights();
+
+    static std::tuple<int16_t, int16_t> get_surface_height(const surface_element* surfaceEl, coord_t x, coord_t y)
+    {
+        if (surfaceEl == nullptr)
+        {
+            return std::make_tuple(16, 0);
+        }
+
+        int16_t waterHeight = surfaceEl->water() * 16;
+        int16_t height = surfaceEl->base_z() * 4;
+        height += _slopeHeights[surfaceEl->slope()][(y & 0x1f) * tile_size + (x & 0x1f)];
+        return std::make_tuple(height, waterHeight);
+    }
+
     /**
     * Return the absolute height of an element, given its (x,y) coordinates
     *
@@ -42,7 +329,7 @@ namespace openloco::map::tilemgr
     * cx: y
     * return dx: height
     * return edx >> 16: waterHeight
-    * loco: 0x0067297 rct2: 0x00662783 (numbers different)
+    * loco: 0x00467297 rct2: 0x00662783 (numbers different)
     */
     std::tuple<int16_t, int16_t> get_height(coord_t x, coord_t y)
     {
@@ -54,9 +341,38 @@ namespace openloco::map::tilemgr
         auto xTile = x & 0xFFE0;
         auto yTile = y & 0xFFE0;
 
-        // Get the surface element for the tile
-        auto surfaceEl = get(xTile, yTile).surface();
+        return get_surface_height(get(xTile, yTile).surface(), x, y);
+    }
+
+    // Gets the heights of many positions at once. Positions on the same tile as the previous
+    // one reuse its surface element, so ordering them by tile avoids repeated tile lookups.
+    void get_heights(const map_pos* positions, size_t count, std::tuple<int16_t, int16_t>* heights)
+    {
+        const surface_element* surfaceEl = nullptr;
+        map_pos surfaceTile{ -1, -1 };
+        for (size_t i = 0; i < count; i++)
+        {
+            auto x = positions[i].x;
+            auto y = positions[i].y;
+            if ((unsigned)x >= 12287 || (unsigned)y >= 12287)
+            {
+                heights[i] = std::make_tuple(16, 0);
+                continue;
+            }
 
+            map_pos tilePos{ static_cast<coord_t>(x & 0xFFE0), static_cast<coord_t>(y & 0xFFE0) };
+            if (tilePos != surfaceTile)
+            {
+                surfaceTile = tilePos;
+                surfaceEl = get(tilePos).surface();
+            }
+            heights[i] = get_surface_height(surfaceEl, x, y);
+        }
+    }
+
+    // The slope logic of get_height before the slope height table, kept verbatim for benchmark_slope_heights
+    static std::tuple<int16_t, int16_t> get_surface_height_by_switch(const surface_element* surfaceEl, coord_t x, coord_t y)
+    {
         if (surfaceEl == nullptr)
         {
             return std::make_tuple(16, 0);
@@ -187,6 +503,80 @@ namespace openloco::map::tilemgr
 
         return std::make_tuple(height, waterHeight);
     }
+    // Checks the slope height table against the switch it replaced for every slope and every position
+    // within a tile, and get_height and get_heights against loco's 0x00467297 over the loaded map.
+    // Then times random positions on the map each way.
+    bool benchmark_slope_heights()
+    {
+        uint32_t mismatches = 0;
+
+        std::array<uint8_t, sizeof(surface_element)> element{};
+        auto surfaceEl = reinterpret_cast<const surface_element*>(element.data());
+        for (int slope = 0; slope < 256; slope++)
+        {
+            for (uint8_t baseZ : { 0, 1, 64, 255 })
+            {
+                element[2] = baseZ;
+                element[4] = static_cast<uint8_t>(slope);
+                element[5] = static_cast<uint8_t>(slope);
+                for (coord_t y = 0; y < tile_size; y++)
+                {
+                    for (coord_t x = 0; x < tile_size; x++)
+                    {
+                        mismatches += get_surface_height(surfaceEl, x, y) != get_surface_height_by_switch(surfaceEl, x, y);
+                    }
+                }
+            }
+        }
+
+        // Positions anywhere on the map, from a fixed seed so that every run times the same positions
+        constexpr size_t numPositions = 1 << 20;
+        std::vector<map_pos> positions(numPositions);
+        uint32_t seed = 0x12345678;
+        for (auto& pos : positions)
+        {
+            seed = seed * 1664525 + 1013904223;
+            pos.x = static_cast<coord_t>((seed >> 16) % map_width);
+            seed = seed * 1664525 + 1013904223;
+            pos.y = static_cast<coord_t>((seed >> 16) % map_height);
+        }
+
+        std::vector<std::tuple<int16_t, int16_t>> heights(numPositions);
+        get_heights(positions.data(), numPositions, heights.data());
+        for (size_t i = 0; i < numPositions; i++)
+        {
+            auto [x, y] = positions[i];
+            auto height = get_height(x, y);
+            auto original = tileElementHeight(x, y);
+            mismatches += height != std::make_tuple(original.landHeight, original.waterHeight);
+            mismatches += heights[i] != height;
+        }
+        if (mismatches != 0)
+        {
+            console::error("  %u heights differ", mismatches);
+        }
+
+        volatile int16_t sink = 0;
+        benchmark::measure("height, loco", numPositions, [&](uint32_t i) {
+            sink = sink + tileElementHeight(positions[i].x, positions[i].y).landHeight;
+        });
+        benchmark::measure("height, slope switch", numPositions, [&](uint32_t i) {
+            auto surface = get(positions[i].x & 0xFFE0, positions[i].y & 0xFFE0).surface();
+            sink = sink + std::get<0>(get_surface_height_by_switch(surface, positions[i].x, positions[i].y));
+        });
+        benchmark::measure("height, slope table", numPositions, [&](uint32_t i) {
+            sink = sink + std::get<0>(get_height(positions[i].x, positions[i].y));
+        });
+
+        // Batched lookups pay off when positions on the same tile follow each other
+        std::sort(positions.begin(), positions.end(), [](const map_pos& a, const map_pos& b) {
+            return std::make_tuple(a.y & 0xFFE0, a.x & 0xFFE0) < std::make_tuple(b.y & 0xFFE0, b.x & 0xFFE0);
+        });
+        auto start = benchmark::clock::now();
+        get_heights(positions.data(), numPositions, heights.data());
+        benchmark::report("height, batched by tile", numPositions, benchmark::clock::now() - start);
+        return mismatches == 0;
+    }
 
     // 0x004610F2
     void map_invalidate_selection_rect()
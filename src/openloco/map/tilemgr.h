@@ -1,6 +1,7 @@
 #pragma once
 
 #include "tile.h"
+#include <cstddef>
 #include <cstdint>
 #include <tuple>
 
@@ -12,10 +13,21 @@ namespace openloco::map::tilemgr
         enableConstruct = (1 << 1)
     };
 
+    struct element_storage_stats
+    {
+        uint32_t elements;           // Elements in use by tiles
+        uint32_t span;               // Elements from the first to the end of the last tile
+        uint32_t out_of_order_tiles; // Tiles whose elements do not follow those of the previous tile
+    };
+
     tile get(map_pos pos);
     tile get(coord_t x, coord_t y);
     std::tuple<int16_t, int16_t> get_height(coord_t x, coord_t y);
+    void get_heights(const map_pos* positions, size_t count, std::tuple<int16_t, int16_t>* heights);
     void map_invalidate_selection_rect();
     void map_invalidate_tile_full(map::map_pos pos);
     void map_invalidate_map_selection_tiles();
+    element_storage_stats get_element_storage_stats();
+    void compact_elements();
+    bool benchmark_slope_heights();
 }
@@ -1,8 +1,12 @@
 #include <algorithm>
+#include <array>
+#include <chrono>
 #include <cstring>
 #include <iostream>
+#include <limits>
 #include <setjmp.h>
 #include <string>
+#include <utility>
 #include <vector>
 
 #ifdef _WIN32
@@ -18,10 +22,17 @@
 #undef small
 #endif
 
+#include "Benchmark.h"
+#include "CommandLine.h"
+#include "FramePacer.h"
+#include "Replay.h"
+#include "StateChecksum.h"
+#include "TickProfiler.h"
 #include "Title.h"
 #include "audio/audio.h"
 #include "companymgr.h"
 #include "config.h"
+#include "console.h"
 #include "date.h"
 #include "environment.h"
 #include "graphics/colours.h"
@@ -34,6 +45,7 @@
 #include "localisation/languagefiles.h"
 #include "localisation/languages.h"
 #include "localisation/string_ids.h"
+#include "map/tilemgr.h"
 #include "multiplayer.h"
 #include "objects/objectmgr.h"
 #include "openloco.h"
@@ -90,9 +102,26 @@ namespace openloco
     static loco_global<char[256], 0x011367A0> _11367A0;
     static loco_global<char[256], 0x011368A0> _11368A0;
 
+    static bool _isHeadless = false;
+
+    // Pacing for the main loop, 40 FPS
+    constexpr auto frameTime = std::chrono::milliseconds(25);
+    static FramePacer _framePacer(frameTime);
+
+    // While fast-forwarding the screen is only drawn every 100 ms, the rest of each frame goes to the simulation
+    constexpr auto fastForwardPresentTime = std::chrono::milliseconds(100);
+    static FastForward _fastForward = FastForward::off;
+    static bool _presentFrame = true;
+    static FramePacer::clock::time_point _nextPresent;
+    static FramePacer::clock::duration _tickCost{};
+    static FramePacer::clock::duration _frameSimTime{};
+    static std::array<FramePacer::clock::duration, 2> _frameOverhead{}; // Indexed by whether the frame was presented
+
     static void tick_logic(int32_t count);
     static void tick_logic();
+    static void tick_logic_fast_forward(int32_t count);
     static void tick_wait();
+    static void updatePresentFrame();
     static void date_tick();
     static void sub_46FFCA();
 
@@ -160,6 +189,11 @@ namespace openloco
         return (_screen_flags & screen_flags::unknown_5) != 0;
     }
 
+    bool isHeadless()
+    {
+        return _isHeadless;
+    }
+
     bool is_paused()
     {
         return paused_state;
@@ -344,9 +378,15 @@ namespace openloco
         call(0x004949BC);
         progressbar::set_progress(235);
         progressbar::set_progress(250);
-        ui::initialise_cursors();
+        if (!isHeadless())
+        {
+            ui::initialise_cursors();
+        }
         progressbar::end();
-        ui::initialise();
+        if (!isHeadless())
+        {
+            ui::initialise();
+        }
         initialise_viewports();
         call(0x004284C8);
         call(0x004969DA);
@@ -357,6 +397,12 @@ namespace openloco
 #else
         intro::state(intro::intro_state::end);
 #endif
+        if (isHeadless())
+        {
+            // Nothing is drawn when headless, the simulated game replaces the title screen
+            intro::state(intro::intro_state::end);
+            return;
+        }
         title::start();
         gui::init();
         gfx::clear(gfx::screen_dpi(), 0x0A0A0A0A);
@@ -524,6 +570,8 @@ namespace openloco
         {
             // Premature end of current tick
             std::cout << "tick prematurely ended" << std::endl;
+            tickprofiler::abandonOpenStages();
+            replay::endTick();
             return;
         }
 
@@ -547,6 +595,9 @@ namespace openloco
         uint32_t time = platform::get_time();
         time_since_last_tick = (uint16_t)std::min(time - last_tick_time, 500U);
         last_tick_time = time;
+        _framePacer.beginFrame();
+        _frameSimTime = {};
+        updatePresentFrame();
 
         if (!is_paused())
         {
@@ -675,7 +726,14 @@ namespace openloco
                 }
 
                 sub_46FFCA();
-                tick_logic(numUpdates);
+                if (isFastForwarding())
+                {
+                    tick_logic_fast_forward(numUpdates);
+                }
+                else
+                {
+                    tick_logic(numUpdates);
+                }
 
                 _525F62++;
                 editor_tick();
@@ -728,6 +786,95 @@ namespace openloco
         }
     }
 
+    static int32_t getFastForwardMultiplier()
+    {
+        switch (_fastForward)
+        {
+            case FastForward::x4:
+                return 4;
+            case FastForward::x16:
+                return 16;
+            case FastForward::max:
+                return std::numeric_limits<int32_t>::max();
+            default:
+                return 1;
+        }
+    }
+
+    // Moving average giving the newest sample a weight of 1/8
+    static FramePacer::clock::duration updateAverage(FramePacer::clock::duration average, FramePacer::clock::duration sample)
+    {
+        if (average == FramePacer::clock::duration::zero())
+        {
+            return sample;
+        }
+        return average + (sample - average) / 8;
+    }
+
+    // Runs count ticks multiplied by the fast-forward speed. The ticks beyond count stop early once the measured
+    // cost of a tick predicts that the next one would not finish before the simulation budget of this frame.
+    static void tick_logic_fast_forward(int32_t count)
+    {
+        using clock = FramePacer::clock;
+
+        const auto overhead = _frameOverhead[_presentFrame ? 1 : 0];
+        const auto budget = overhead < frameTime ? frameTime - overhead : clock::duration::zero();
+        const auto multiplier = getFastForwardMultiplier();
+        const auto target = count > std::numeric_limits<int32_t>::max() / multiplier ? std::numeric_limits<int32_t>::max() : count * multiplier;
+
+        const auto simStart = clock::now();
+        for (int32_t i = 0; i < target; i++)
+        {
+            if (i >= count && _framePacer.elapsed() + _tickCost > budget)
+            {
+                break;
+            }
+
+            const auto tickStart = clock::now();
+            tick_logic();
+            _tickCost = updateAverage(_tickCost, clock::now() - tickStart);
+        }
+        _frameSimTime += clock::now() - simStart;
+    }
+
+    FastForward getFastForward()
+    {
+        return _fastForward;
+    }
+
+    void setFastForward(FastForward mode)
+    {
+        if (_fastForward == mode)
+        {
+            return;
+        }
+
+        _fastForward = mode;
+        _tickCost = {};
+        _frameOverhead = {};
+        WindowManager::invalidate(WindowType::timeToolbar);
+    }
+
+    bool isFastForwarding()
+    {
+        return _fastForward != FastForward::off && !isNetworked() && !is_title_mode() && !intro::is_active();
+    }
+
+    bool isPresentingFrame()
+    {
+        return _presentFrame;
+    }
+
+    static void updatePresentFrame()
+    {
+        const auto now = FramePacer::clock::now();
+        _presentFrame = !isFastForwarding() || now >= _nextPresent;
+        if (_presentFrame)
+        {
+            _nextPresent = now + fastForwardPresentTime;
+        }
+    }
+
     // 0x004612EC
     static void invalidate_map_animations()
     {
@@ -755,26 +902,49 @@ namespace openloco
     // 0x0046ABCB
     static void tick_logic()
     {
+        using tickprofiler::Stage;
+
+        tickprofiler::begin(Stage::tick);
+        replay::beginTick();
+
         _scenario_ticks++;
         addr<0x00525F64, int32_t>()++;
         addr<0x00525FCC, uint32_t>() = _prng->srand_0();
         addr<0x00525FD0, uint32_t>() = _prng->srand_1();
         call(0x004613F0);
         addr<0x00F25374, uint8_t>() = s5::getOptions().madeAnyChanges;
+        tickprofiler::begin(Stage::date);
         date_tick();
+        tickprofiler::end(Stage::date);
         call(0x00463ABA);
         call(0x004C56F6);
+        tickprofiler::begin(Stage::towns);
         townmgr::update();
+        tickprofiler::end(Stage::towns);
+        tickprofiler::begin(Stage::industries);
         industrymgr::update();
+        tickprofiler::end(Stage::industries);
+        tickprofiler::begin(Stage::vehicles);
         thingmgr::updateVehicles();
+        tickprofiler::end(Stage::vehicles);
         sub_46FFCA();
+        tickprofiler::begin(Stage::stations);
         stationmgr::update();
+        tickprofiler::end(Stage::stations);
+        tickprofiler::begin(Stage::miscThings);
         thingmgr::updateMiscThings();
+        tickprofiler::end(Stage::miscThings);
         sub_46FFCA();
+        tickprofiler::begin(Stage::companies);
         companymgr::update();
+        tickprofiler::end(Stage::companies);
+        tickprofiler::begin(Stage::mapAnimations);
         invalidate_map_animations();
+        tickprofiler::end(Stage::mapAnimations);
+        tickprofiler::begin(Stage::audio);
         audio::updateVehicleNoise();
         audio::updateAmbientNoise();
+        tickprofiler::end(Stage::audio);
         call(0x00444387);
 
         s5::getOptions().madeAnyChanges = addr<0x00F25374, uint8_t>();
@@ -790,6 +960,10 @@ namespace openloco
             _50C197 = 0;
             ui::windows::showError(title, message);
         }
+
+        replay::endTick();
+        statechecksum::update();
+        tickprofiler::end(Stage::tick);
     }
 
     static void sub_496A84(int32_t edx)
@@ -820,6 +994,8 @@ namespace openloco
                 sub_496A84(today.day_of_olympiad);
                 if (today.month != yesterday.month)
                 {
+                    tickprofiler::begin(tickprofiler::Stage::dateMonthly);
+
                     // End of every month
                     addr<0x0050A004, uint16_t>() += 2;
                     addr<0x00526243, uint16_t>()++;
@@ -847,12 +1023,17 @@ namespace openloco
 
                     if (today.year != yesterday.year)
                     {
+                        tickprofiler::begin(tickprofiler::Stage::dateYearly);
+
                         // End of every year
                         call(0x004312C7);
                         call(0x004796A9);
                         call(0x004C3A9E);
                         call(0x0047AB9B);
+                        tickprofiler::end(tickprofiler::Stage::dateYearly);
                     }
+
+                    tickprofiler::end(tickprofiler::Stage::dateMonthly);
                 }
 
                 call(0x00437FB8);
@@ -860,30 +1041,72 @@ namespace openloco
         }
     }
 
+    // Loads a saved game and runs the game logic as fast as possible without a window,
+    // rendering, audio or frame pacing. Used for profiling the simulation.
+    static void simulate(const CommandLineOptions& options)
+    {
+        _isHeadless = true;
+        initialise();
+
+        if (!s5::load(options.path, 0))
+        {
+            console::error("Unable to load saved game: %s", options.path.c_str());
+            return;
+        }
+
+        console::log("Simulating %u ticks of %s", options.ticks, options.path.c_str());
+        thingmgr::resetListStats();
+        auto startTime = std::chrono::steady_clock::now();
+        tick_logic(options.ticks);
+        auto endTime = std::chrono::steady_clock::now();
+
+        auto seconds = std::chrono::duration<double>(endTime - startTime).count();
+        console::log("Simulated %u ticks in %.3f s (%.1f ticks/s)", options.ticks, seconds, options.ticks / seconds);
+        console::log("Final state checksum: %08X", statechecksum::compute().total);
+
+        constexpr std::pair<thingmgr::thing_list, const char*> lists[] = {
+            { thingmgr::thing_list::vehicle, "vehicles" },
+            { thingmgr::thing_list::misc, "misc things" },
+        };
+        for (const auto& [list, name] : lists)
+        {
+            auto stats = thingmgr::getListStats(list);
+            console::log("%s: %u (peak %u), %u allocated and %u freed natively", name, stats.count, stats.highWaterMark, stats.allocations, stats.frees);
+        }
+    }
+
     // 0x0046AD4D
     void tick_wait()
     {
-        do
+        // Keep track of the time spent outside of the simulation so fast-forward leaves room for it
+        if (isFastForwarding())
         {
-            // Idle loop for a 40 FPS
-        } while (platform::get_time() - last_tick_time < 25);
+            auto& overhead = _frameOverhead[_presentFrame ? 1 : 0];
+            overhead = updateAverage(overhead, _framePacer.elapsed() - _frameSimTime);
+        }
+
+        // Sleep for the remainder of the frame for 40 FPS
+        _framePacer.waitForNextFrame();
+    }
+
+    FramePacer::Stats getFrameStats()
+    {
+        return _framePacer.getStats();
     }
 
     void prompt_tick_loop(std::function<bool()> tickAction)
     {
+        FramePacer pacer(frameTime);
         while (true)
         {
-            auto startTime = platform::get_time();
+            pacer.beginFrame();
             time_since_last_tick = 31;
             if (!ui::process_messages() || !tickAction())
             {
                 break;
             }
             ui::render();
-            do
-            {
-                // Idle loop for a 40 FPS
-            } while (platform::get_time() - startTime < 25);
+            pacer.waitForNextFrame();
         }
     }
 
@@ -922,7 +1145,10 @@ namespace openloco
             }
             sub_4062E0();
             tick();
-            ui::render();
+            if (isPresentingFrame())
+            {
+                ui::render();
+            }
         }
         sub_40567E();
 
@@ -931,6 +1157,21 @@ namespace openloco
 #endif
     }
 
+    // Runs the benchmarks without a window. They need the g1 and the loco routines they compare against.
+    static void runBenchmarks(const CommandLineOptions& options)
+    {
+        _isHeadless = true;
+        initialise();
+
+        if (benchmark::run(options.benchmarkFilter))
+        {
+            console::log("All benchmark results match");
+        }
+#ifdef _WIN32
+        CoUninitialize();
+#endif
+    }
+
     // 0x00406D13
     void main()
     {
@@ -944,6 +1185,34 @@ namespace openloco
             register_hooks();
             if (sub_4054B9())
             {
+                const auto& options = getCommandLineOptions();
+                if (!options.tickProfilePath.empty())
+                {
+                    tickprofiler::startCsv(options.tickProfilePath);
+                }
+                if (!options.checksumLogPath.empty())
+                {
+                    statechecksum::startLog(options.checksumLogPath, options.checksumInterval);
+                }
+
+                if (options.action == CommandLineAction::simulate)
+                {
+                    simulate(options);
+                    tickprofiler::stopCsv();
+                    statechecksum::stopLog();
+                    if (interop::is_call_profile_enabled())
+                    {
+                        interop::print_call_profile();
+                    }
+                    return;
+                }
+
+                if (options.action == CommandLineAction::benchmark)
+                {
+                    runBenchmarks(options);
+                    return;
+                }
+
                 ui::create_window(cfg.display);
                 call(0x004078FE);
                 call(0x00407B26);
@@ -953,6 +1222,12 @@ namespace openloco
                 audio::disposeDSound();
                 ui::dispose_cursors();
                 ui::dispose_input();
+                tickprofiler::stopCsv();
+                statechecksum::stopLog();
+                if (interop::is_call_profile_enabled())
+                {
+                    interop::print_call_profile();
+                }
 
                 // TODO extra clean up code
             }
@@ -975,6 +1250,16 @@ extern "C" {
 __declspec(dllexport) int StartOpenLoco(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow);
 __declspec(dllexport) int StartOpenLoco(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow)
 {
+    // lpCmdLine does not include the executable path
+    auto args = openloco::splitCommandLine(lpCmdLine);
+    args.insert(args.begin(), "openloco");
+    auto options = openloco::parseCommandLine(args);
+    if (!options)
+    {
+        return 1;
+    }
+    openloco::setCommandLineOptions(*options);
+
     openloco::glpCmdLine = lpCmdLine;
     openloco::ghInstance = hInstance;
     openloco::main();
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "FramePacer.h"
 #include "utility/prng.hpp"
 #include <cstdint>
 #include <functional>
@@ -19,6 +20,15 @@ namespace openloco
         constexpr uint8_t unknown_6 = 1 << 6;
     }
 
+    // Native fast-forward, applied on top of the game speed
+    enum class FastForward : uint8_t
+    {
+        off,
+        x4,
+        x16,
+        max,
+    };
+
     extern const char version[];
 
     std::string get_version_info();
@@ -34,6 +44,7 @@ namespace openloco
     bool isTrackUpgradeMode();
     bool is_unknown_4_mode();
     bool is_unknown_5_mode();
+    bool isHeadless();
     bool is_paused();
     uint8_t get_pause_flags();
     void togglePause(bool value);
@@ -44,5 +55,10 @@ namespace openloco
     void sub_431695(uint16_t var_F253A0);
     void main();
     void prompt_tick_loop(std::function<bool()> tickAction);
+    FramePacer::Stats getFrameStats();
+    FastForward getFastForward();
+    void setFastForward(FastForward mode);
+    bool isFastForwarding();
+    bool isPresentingFrame();
     void exit_with_error(openloco::string_id message, uint32_t errorCode);
 }
@@ -1,5 +1,6 @@
 #ifndef _WIN32
 
+#include "../CommandLine.h"
 #include "../console.h"
 #include "../interop/interop.hpp"
 #include "../openloco.h"
@@ -21,6 +22,13 @@
 
 int main(int argc, const char** argv)
 {
+    auto options = openloco::parseCommandLine(std::vector<std::string>(argv, argv + argc));
+    if (!options)
+    {
+        return 1;
+    }
+    openloco::setCommandLineOptions(*options);
+
     openloco::interop::load_sections();
     openloco::lpCmdLine((char*)argv[0]);
     openloco::main();
@@ -29,11 +37,12 @@ int main(int argc, const char** argv)
 
 namespace openloco::platform
 {
+    // Milliseconds from an arbitrary, monotonic starting point
     uint32_t get_time()
     {
         struct timespec spec;
-        clock_gettime(CLOCK_REALTIME, &spec);
-        return spec.tv_nsec / 1000000;
+        clock_gettime(CLOCK_MONOTONIC, &spec);
+        return static_cast<uint32_t>(static_cast<uint64_t>(spec.tv_sec) * 1000 + spec.tv_nsec / 1000000);
     }
 
     std::vector<fs::path> getDrives()
@@ -1,5 +1,6 @@
 #include "s5.h"
 #include "../interop/interop.hpp"
+#include "../utility/string.hpp"
 
 using namespace openloco::interop;
 
@@ -8,6 +9,7 @@ namespace openloco::s5
     static loco_global<Options, 0x009C8714> _activeOptions;
     static loco_global<Header, 0x009CCA34> _header;
     static loco_global<Options, 0x009CCA54> _previewOptions;
+    static loco_global<char[512], 0x0112CE04> _savePath;
 
     Options& getOptions()
     {
@@ -18,4 +20,16 @@ namespace openloco::s5
     {
         return _previewOptions;
     }
+
+    // 0x00441FA7
+    // eax: flags
+    // returns carry flag on failure
+    bool load(const fs::path& path, uint32_t flags)
+    {
+        utility::strcpy_safe(_savePath, path.u8string().c_str());
+
+        registers regs;
+        regs.eax = flags;
+        return (call(0x00441FA7, regs) & X86_FLAG_CARRY) == 0;
+    }
 }
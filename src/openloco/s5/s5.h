@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../core/FileSystem.hpp"
 #include "../objects/objectmgr.h"
 #include <cstdint>
 
@@ -109,4 +110,5 @@ namespace openloco::s5
 
     Options& getOptions();
     Options& getPreviewOptions();
+    bool load(const fs::path& path, uint32_t flags);
 }
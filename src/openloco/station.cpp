@@ -159,8 +159,10 @@ namespace openloco
         }
     };
 
-    static void sub_491BF5(const map_pos& pos, const uint8_t flag);
     static station_element* getStationElement(const map_pos3& pos);
+    static void clampCatchmentRegion(CatchmentRegion& region);
+    static void setStationCatchmentRegion(CargoSearchState& cargoSearchState, TilePos minPos, TilePos maxPos, const uint8_t flag);
+    static CatchmentRegion getLocationCatchmentRegion(const map_pos& pos);
 
     station_id_t station::id() const
     {
@@ -251,11 +253,36 @@ namespace openloco
 
         cargoSearchState.resetIndustryMap();
 
-        setCatchmentDisplay(1);
-
+        // The catchment only covers the tiles around the station, so rather than clearing
+        // and scanning the whole map only the rectangle bounding the catchment is used.
+        std::vector<CatchmentRegion> regions;
+        if (this != (station*)0xFFFFFFFF)
+        {
+            regions = getCatchmentRegions();
+        }
         if (location.x != -1)
         {
-            sub_491BF5(location, 1);
+            regions.push_back(getLocationCatchmentRegion(location));
+        }
+
+        TilePos boundsMin(map_columns, map_rows);
+        TilePos boundsMax(-1, -1);
+        for (auto& region : regions)
+        {
+            clampCatchmentRegion(region);
+            boundsMin.x = std::min(boundsMin.x, region.min.x);
+            boundsMin.y = std::min(boundsMin.y, region.min.y);
+            boundsMax.x = std::max(boundsMax.x, region.max.x);
+            boundsMax.y = std::max(boundsMax.y, region.max.y);
+        }
+
+        if (!regions.empty())
+        {
+            cargoSearchState.resetTileRegion(boundsMin.x, boundsMin.y, boundsMax.x - boundsMin.x + 1, boundsMax.y - boundsMin.y + 1, 1);
+            for (const auto& region : regions)
+            {
+                setStationCatchmentRegion(cargoSearchState, region.min, region.max, 1);
+            }
         }
 
         cargoSearchState.resetScores();
@@ -300,9 +327,9 @@ namespace openloco
             cargoSearchState.filter(~0);
         }
 
-        for (tile_coord_t ty = 0; ty < map_columns; ty++)
+        for (tile_coord_t ty = boundsMin.y; ty <= boundsMax.y; ty++)
         {
-            for (tile_coord_t tx = 0; tx < map_rows; tx++)
+            for (tile_coord_t tx = boundsMin.x; tx <= boundsMax.x; tx++)
             {
                 if (cargoSearchState.mapHas2(tx, ty))
                 {
@@ -428,8 +455,6 @@ namespace openloco
         return acceptedCargos;
     }
 
-    static void setStationCatchmentRegion(CargoSearchState& cargoSearchState, TilePos minPos, TilePos maxPos, const uint8_t flags);
-
     // 0x00491D70
     // catchment flag should not be shifted (1, 2, 3, 4) and NOT (1 << 0, 1 << 1)
     void station::setCatchmentDisplay(const uint8_t catchmentFlag)
@@ -440,9 +465,17 @@ namespace openloco
         if (this == (station*)0xFFFFFFFF)
             return;
 
-        if (stationTileSize == 0)
-            return;
+        for (const auto& region : getCatchmentRegions())
+        {
+            setStationCatchmentRegion(cargoSearchState, region.min, region.max, catchmentFlag);
+        }
+    }
 
+    // Part of 0x00491D70
+    // Returns the unclamped tile regions making up the catchment of each station tile
+    std::vector<CatchmentRegion> station::getCatchmentRegions() const
+    {
+        std::vector<CatchmentRegion> regions;
         for (uint16_t i = 0; i < stationTileSize; i++)
         {
             auto pos = stationTiles[i];
@@ -491,7 +524,7 @@ namespace openloco
                     tileMaxPos.x += catchmentSize;
                     tileMaxPos.y += catchmentSize;
 
-                    setStationCatchmentRegion(cargoSearchState, tileMinPos, tileMaxPos, catchmentFlag);
+                    regions.push_back({ tileMinPos, tileMaxPos });
                 }
                 break;
                 case stationType::docks:
@@ -505,7 +538,7 @@ namespace openloco
                     maxPos.x += catchmentSize + 1;
                     maxPos.y += catchmentSize + 1;
 
-                    setStationCatchmentRegion(cargoSearchState, minPos, maxPos, catchmentFlag);
+                    regions.push_back({ minPos, maxPos });
                 }
                 break;
                 default:
@@ -518,10 +551,11 @@ namespace openloco
                     maxPos.x += catchmentSize;
                     maxPos.y += catchmentSize;
 
-                    setStationCatchmentRegion(cargoSearchState, minPos, maxPos, catchmentFlag);
+                    regions.push_back({ minPos, maxPos });
                 }
             }
         }
+        return regions;
     }
 
     // 0x0048F7D1
@@ -749,24 +783,25 @@ namespace openloco
         return nullptr;
     }
 
+    static void clampCatchmentRegion(CatchmentRegion& region)
+    {
+        region.min.x = std::max(region.min.x, static_cast<coord_t>(0));
+        region.min.y = std::max(region.min.y, static_cast<coord_t>(0));
+        region.max.x = std::min(region.max.x, static_cast<coord_t>(map_columns - 1));
+        region.max.y = std::min(region.max.y, static_cast<coord_t>(map_rows - 1));
+    }
+
     // 0x00491EDC
     static void setStationCatchmentRegion(CargoSearchState& cargoSearchState, TilePos minPos, TilePos maxPos, const uint8_t flag)
     {
-        minPos.x = std::max(minPos.x, static_cast<coord_t>(0));
-        minPos.y = std::max(minPos.y, static_cast<coord_t>(0));
-        maxPos.x = std::min(maxPos.x, static_cast<coord_t>(map_columns - 1));
-        maxPos.y = std::min(maxPos.y, static_cast<coord_t>(map_rows - 1));
-
-        maxPos.x -= minPos.x;
-        maxPos.y -= minPos.y;
-        maxPos.x++;
-        maxPos.y++;
+        CatchmentRegion region{ minPos, maxPos };
+        clampCatchmentRegion(region);
 
-        cargoSearchState.setTileRegion(minPos.x, minPos.y, maxPos.x, maxPos.y, flag);
+        cargoSearchState.setTileRegion(region.min.x, region.min.y, region.max.x - region.min.x + 1, region.max.y - region.min.y + 1, flag);
     }
 
-    // 0x00491BF5
-    static void sub_491BF5(const map_pos& pos, const uint8_t flag)
+    // Part of 0x00491BF5
+    static CatchmentRegion getLocationCatchmentRegion(const map_pos& pos)
     {
         TilePos minPos(pos);
         auto maxPos = minPos;
@@ -774,9 +809,6 @@ namespace openloco
         maxPos.y += catchmentSize;
         minPos.x -= catchmentSize;
         minPos.y -= catchmentSize;
-
-        CargoSearchState cargoSearchState;
-
-        setStationCatchmentRegion(cargoSearchState, minPos, maxPos, flag);
+        return { minPos, maxPos };
     }
 }
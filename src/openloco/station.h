@@ -7,6 +7,7 @@
 #include "utility/numeric.hpp"
 #include <cstdint>
 #include <limits>
+#include <vector>
 
 namespace openloco
 {
@@ -74,6 +75,13 @@ namespace openloco
 
     struct CargoSearchState;
 
+    // Inclusive rectangle of tiles
+    struct CatchmentRegion
+    {
+        TilePos min;
+        TilePos max;
+    };
+
     struct station
     {
         string_id name; // 0x00
@@ -106,6 +114,7 @@ namespace openloco
         void invalidate();
         void invalidate_window();
         void setCatchmentDisplay(uint8_t flags);
+        std::vector<CatchmentRegion> getCatchmentRegions() const;
 
     private:
         void update_cargo_acceptance();
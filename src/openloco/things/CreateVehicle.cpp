@@ -175,17 +175,10 @@ namespace openloco::things::vehicle
     }
 
     // 0x00470039
-    static openloco::vehicle_base* createVehicleThing()
-    {
-        registers regs{};
-        call(0x00470039, regs);
-        return reinterpret_cast<openloco::vehicle_base*>(regs.esi);
-    }
-
     template<typename T>
     static T* createVehicleThing()
     {
-        auto* const base = createVehicleThing();
+        auto* const base = thingmgr::createVehicleThing();
         base->base_type = thing_base_type::vehicle;
         base->type = T::vehicleThingType;
         return reinterpret_cast<T*>(base);
@@ -521,35 +514,10 @@ namespace openloco::things::vehicle
         newHead->var_4C = 1;
     }
 
-    // 0x004B64F9
-    static uint16_t createUniqueTypeNumber(const VehicleType type)
-    {
-        std::array<bool, max_num_vehicles> _unkArr{};
-        for (auto v : thingmgr::VehicleList())
-        {
-            if (v->owner == _updating_company_id && v->vehicleType == type)
-            {
-                if (v->var_44 != 0)
-                {
-                    _unkArr[v->var_44 - 1] = true;
-                }
-            }
-        }
-
-        uint16_t newNum = 0;
-        for (; newNum < _unkArr.size(); ++newNum)
-        {
-            if (!_unkArr[newNum])
-                break;
-        }
-        return newNum + 1;
-    }
-
     // 0x004AE34B
     static openloco::vehicle_head* createHead(const uint8_t trackType, const TransportMode mode, const uint16_t orderId, const VehicleType vehicleType)
     {
         auto* const newHead = createVehicleThing<vehicle_head>();
-        thingmgr::moveSpriteToList(newHead, thingmgr::thing_list::vehicle_head);
         newHead->owner = _updating_company_id;
         newHead->head = newHead->id;
         newHead->var_0C |= (1 << 1);
@@ -569,8 +537,10 @@ namespace openloco::things::vehicle
         newHead->var_3C = 0;
         newHead->vehicleType = vehicleType;
         newHead->var_22 = static_cast<uint8_t>(vehicleType) + 4;
-        newHead->var_44 = 0; // Reset to null value so ignored in next function
-        newHead->var_44 = createUniqueTypeNumber(vehicleType);
+        newHead->var_44 = thingmgr::getFreeVehicleNumber(_updating_company_id, vehicleType);
+        // Moved to the list of heads once numbered, so that the vehicle index sees it arrive
+        thingmgr::moveSpriteToList(newHead, thingmgr::thing_list::vehicle_head);
+        thingmgr::addToVehicleIndex(newHead);
         newHead->var_5D = 0;
         newHead->var_54 = -1;
         newHead->var_5F = 0;
@@ -932,13 +902,16 @@ namespace openloco::things::vehicle
     {
         gGameCommandExpenditureType = static_cast<uint8_t>(ExpenditureType::VehiclePurchases) * 4;
         _backupVeh0 = reinterpret_cast<openloco::vehicle_head*>(-1);
+        uint32_t result;
         if (vehicleThingId == (uint16_t)-1)
         {
-            return createNewVehicle(flags, vehicleTypeId);
+            result = createNewVehicle(flags, vehicleTypeId);
         }
         else
         {
-            return addCarToVehicle(flags, vehicleTypeId, vehicleThingId);
+            result = addCarToVehicle(flags, vehicleTypeId, vehicleThingId);
         }
+        thingmgr::releaseReservedThings();
+        return result;
     }
 }
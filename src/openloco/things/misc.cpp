@@ -1,4 +1,5 @@
 #include "misc.h"
+#include "../config.h"
 #include "../map/tilemgr.h"
 #include "../objects/objectmgr.h"
 #include "../objects/steam_object.h"
@@ -7,6 +8,15 @@
 using namespace openloco;
 using namespace openloco::objectmgr;
 
+// Smoke and exhaust are purely decorative, so they are dropped once the configured budget is used up.
+// The budget counts every misc thing, including the effects that are not smoke or exhaust, as loco
+// frees misc things without going through thingmgr and so they cannot be counted by type cheaply.
+static bool isWithinParticleBudget()
+{
+    auto budget = config::get_new().particle_budget;
+    return budget == 0 || thingmgr::getListCount(thingmgr::thing_list::misc) < budget;
+}
+
 steam_object* openloco::exhaust::object() const
 {
     return objectmgr::get<steam_object>(object_id & 0x7F);
@@ -25,6 +35,9 @@ exhaust* openloco::exhaust::create(loc16 loc, uint8_t type)
     if (loc.z <= surface->base_z() * 4)
         return nullptr;
 
+    if (!isWithinParticleBudget())
+        return nullptr;
+
     auto _exhaust = static_cast<exhaust*>(thingmgr::createThing());
 
     if (_exhaust != nullptr)
@@ -49,6 +62,9 @@ exhaust* openloco::exhaust::create(loc16 loc, uint8_t type)
 // 0x00440BEB
 smoke* openloco::smoke::create(loc16 loc)
 {
+    if (!isWithinParticleBudget())
+        return nullptr;
+
     auto t = static_cast<smoke*>(thingmgr::createThing());
     if (t != nullptr)
     {
@@ -1,6 +1,12 @@
 #include "thingmgr.h"
+#include "../companymgr.h"
+#include "../config.h"
 #include "../interop/interop.hpp"
 #include "../openloco.h"
+#include "../utility/numeric.hpp"
+#include "../viewportmgr.h"
+#include <algorithm>
+#include <array>
 
 using namespace openloco::interop;
 
@@ -11,6 +17,34 @@ namespace openloco::thingmgr
     loco_global<Thing[max_things], 0x006DB6DC> _things;
     static loco_global<string_id, 0x009C68E6> gGameCommandErrorText;
 
+    // Vehicle numbers are unique per company and vehicle type, starting from 1. Numbers in use are
+    // tracked up to max_vehicle_numbers.
+    constexpr size_t vehicle_number_words = 16;
+    constexpr size_t max_vehicle_numbers = vehicle_number_words * 64;
+
+    struct CompanyVehicles
+    {
+        std::vector<thing_id_t> heads;
+        std::array<uint64_t, vehicle_number_words> usedNumbers;
+    };
+
+    // Kept up to date as vehicles are created and freed natively. Loco code frees vehicle heads and
+    // transfers them between companies without telling us, which is noticed from the number of heads
+    // and the names of the companies no longer matching what the index has seen.
+    struct VehicleIndex
+    {
+        std::array<std::array<CompanyVehicles, vehicleTypeCount>, companymgr::max_companies> companies;
+        std::array<string_id, companymgr::max_companies> companyNames;
+        size_t numHeads = 0;
+        bool valid = false;
+    };
+
+    static VehicleIndex _vehicleIndex;
+
+    // Free things held back for vehicle things about to be created by the caller of checkNumFreeThings
+    static size_t _reservedThings;
+    static std::array<ThingListStats, num_thing_lists> _listStats;
+
     thing_id_t firstId(thing_list list)
     {
         return _heads[(size_t)list];
@@ -38,17 +72,217 @@ namespace openloco::thingmgr
         return result;
     }
 
+    static void recordAllocation(const thing_list list)
+    {
+        auto& stats = _listStats[static_cast<size_t>(list)];
+        stats.allocations++;
+        stats.highWaterMark = std::max(stats.highWaterMark, getListCount(list));
+    }
+
     // 0x004700A5
+    // Free things that are reserved for vehicles are not given out to misc things. The misc_thing_headroom
+    // option also holds back the last free things, so that vehicles stay buildable on large networks where
+    // smoke and exhaust would otherwise fill the rest of the pool.
     thing_base* createThing()
     {
+        size_t headroom = config::get_new().misc_thing_headroom;
+        if (getListCount(thing_list::null) <= std::max(_reservedThings, headroom))
+        {
+            return nullptr;
+        }
+
         registers regs;
         call(0x004700A5, regs);
-        return (thing_base*)regs.esi;
+        auto thing = (thing_base*)regs.esi;
+        if (thing != nullptr)
+        {
+            recordAllocation(thing_list::misc);
+        }
+        return thing;
+    }
+
+    // 0x00470039
+    vehicle_base* createVehicleThing()
+    {
+        registers regs;
+        call(0x00470039, regs);
+        auto thing = (vehicle_base*)regs.esi;
+        if (thing != nullptr)
+        {
+            if (_reservedThings > 0)
+            {
+                _reservedThings--;
+            }
+            recordAllocation(thing_list::vehicle);
+        }
+        return thing;
+    }
+
+    static CompanyVehicles* getVehicleIndexSlot(company_id_t owner, VehicleType type)
+    {
+        if (owner >= companymgr::max_companies || static_cast<uint8_t>(type) >= vehicleTypeCount)
+        {
+            return nullptr;
+        }
+        return &_vehicleIndex.companies[owner][static_cast<uint8_t>(type)];
+    }
+
+    static void setVehicleNumberUsed(CompanyVehicles& vehicles, uint16_t number, bool used)
+    {
+        if (number > 0 && number <= max_vehicle_numbers)
+        {
+            auto& word = vehicles.usedNumbers[(number - 1) / 64];
+            word = utility::setMask<uint64_t>(word, uint64_t(1) << ((number - 1) % 64), used);
+        }
+    }
+
+    static void rebuildVehicleIndex()
+    {
+        auto& index = _vehicleIndex;
+        for (auto& company : index.companies)
+        {
+            for (auto& vehicles : company)
+            {
+                vehicles.heads.clear();
+                vehicles.usedNumbers.fill(0);
+            }
+        }
+
+        index.numHeads = 0;
+        for (auto v : VehicleList())
+        {
+            index.numHeads++;
+            auto vehicles = getVehicleIndexSlot(v->owner, v->vehicleType);
+            if (vehicles != nullptr)
+            {
+                vehicles->heads.push_back(v->id);
+                setVehicleNumberUsed(*vehicles, v->var_44, true);
+            }
+        }
+
+        for (company_id_t id = 0; id < companymgr::max_companies; id++)
+        {
+            index.companyNames[id] = companymgr::get(id)->name;
+        }
+        index.valid = true;
+    }
+
+    // Whether loco code may have freed or transferred vehicles since the index was last updated, given
+    // the number of heads expected in the list.
+    static bool isVehicleIndexStale(size_t numHeads)
+    {
+        const auto& index = _vehicleIndex;
+        if (!index.valid || getListCount(thing_list::vehicle_head) != numHeads)
+        {
+            return true;
+        }
+
+        // Companies that were taken over or went bankrupt have been removed
+        for (company_id_t id = 0; id < companymgr::max_companies; id++)
+        {
+            if (companymgr::get(id)->name != index.companyNames[id])
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static CompanyVehicles& getVehicleIndexEntry(company_id_t owner, VehicleType type)
+    {
+        if (isVehicleIndexStale(_vehicleIndex.numHeads))
+        {
+            rebuildVehicleIndex();
+        }
+        return _vehicleIndex.companies[owner][static_cast<uint8_t>(type)];
+    }
+
+    // Gets the heads of the vehicles of a type owned by a company, in no particular order.
+    const std::vector<thing_id_t>& getCompanyVehicles(company_id_t owner, VehicleType type)
+    {
+        return getVehicleIndexEntry(owner, type).heads;
+    }
+
+    // 0x004B64F9
+    // Gets the lowest vehicle number not used by the company's vehicles of the type.
+    uint16_t getFreeVehicleNumber(company_id_t owner, VehicleType type)
+    {
+        const auto& usedNumbers = getVehicleIndexEntry(owner, type).usedNumbers;
+        for (size_t word = 0; word < usedNumbers.size(); word++)
+        {
+            if (usedNumbers[word] != ~uint64_t(0))
+            {
+                return static_cast<uint16_t>(word * 64 + utility::bitScanForward64(~usedNumbers[word]) + 1);
+            }
+        }
+        return max_vehicle_numbers + 1;
+    }
+
+    // Adds a vehicle head that has just been numbered and moved to the list of vehicle heads.
+    void addToVehicleIndex(const vehicle_head* head)
+    {
+        if (isVehicleIndexStale(_vehicleIndex.numHeads + 1))
+        {
+            // The head is picked up when the index is rebuilt
+            _vehicleIndex.valid = false;
+            return;
+        }
+
+        _vehicleIndex.numHeads++;
+        auto vehicles = getVehicleIndexSlot(head->owner, head->vehicleType);
+        if (vehicles != nullptr)
+        {
+            vehicles->heads.push_back(head->id);
+            setVehicleNumberUsed(*vehicles, head->var_44, true);
+        }
+    }
+
+    // Removes a vehicle head that is about to be freed.
+    static void removeFromVehicleIndex(const vehicle_head* head)
+    {
+        if (isVehicleIndexStale(_vehicleIndex.numHeads))
+        {
+            _vehicleIndex.valid = false;
+            return;
+        }
+
+        _vehicleIndex.numHeads--;
+        auto vehicles = getVehicleIndexSlot(head->owner, head->vehicleType);
+        if (vehicles != nullptr)
+        {
+            auto& heads = vehicles->heads;
+            auto it = std::find(heads.begin(), heads.end(), head->id);
+            if (it != heads.end())
+            {
+                *it = heads.back();
+                heads.pop_back();
+            }
+            setVehicleNumberUsed(*vehicles, head->var_44, false);
+        }
+    }
+
+    // Must be called whenever the vehicles are replaced, e.g. when a game is loaded. The index is
+    // rebuilt on the next query.
+    void invalidateVehicleIndex()
+    {
+        _vehicleIndex.valid = false;
     }
 
     // 0x0047024A
     void freeThing(thing_base* const thing)
     {
+        // Vehicle heads are counted with the vehicles they were allocated as
+        auto list = thing->base_type == thing_base_type::vehicle ? thing_list::vehicle : thing_list::misc;
+        _listStats[static_cast<size_t>(list)].frees++;
+        if (list == thing_list::vehicle)
+        {
+            auto head = static_cast<vehicle_base*>(thing)->asVehicleHead();
+            if (head != nullptr)
+            {
+                removeFromVehicleIndex(head);
+            }
+        }
+
         registers regs;
         regs.esi = reinterpret_cast<uint32_t>(thing);
         call(0x0047024A, regs);
@@ -69,7 +303,9 @@ namespace openloco::thingmgr
     // 0x004402F4
     void updateMiscThings()
     {
+        ui::viewportmgr::beginBatchedInvalidation();
         call(0x004402F4);
+        ui::viewportmgr::endBatchedInvalidation();
     }
 
     // 0x0047019F
@@ -82,6 +318,8 @@ namespace openloco::thingmgr
     }
 
     // 0x00470188
+    // Reserves the things so that misc things created in the meantime cannot leave the caller with
+    // only some of them. The reservation replaces any previous one.
     bool checkNumFreeThings(const size_t numNewThings)
     {
         if (thingmgr::getListCount(thingmgr::thing_list::null) <= numNewThings)
@@ -89,6 +327,28 @@ namespace openloco::thingmgr
             gGameCommandErrorText = string_ids::too_many_objects_in_game;
             return false;
         }
+        _reservedThings = numNewThings;
         return true;
     }
+
+    // Gives back the things reserved by checkNumFreeThings that were not created.
+    void releaseReservedThings()
+    {
+        _reservedThings = 0;
+    }
+
+    // Allocations and frees only count things allocated and freed through thingmgr. Loco code also
+    // allocates and frees things itself, for example when misc things expire, which is not counted.
+    ThingListStats getListStats(const thing_list list)
+    {
+        auto stats = _listStats[static_cast<size_t>(list)];
+        stats.count = getListCount(list);
+        stats.highWaterMark = std::max(stats.highWaterMark, stats.count);
+        return stats;
+    }
+
+    void resetListStats()
+    {
+        _listStats.fill({});
+    }
 }
@@ -3,17 +3,28 @@
 #include "thing.h"
 #include "vehicle.h"
 #include <cstdio>
+#include <vector>
 
 namespace openloco::thingmgr
 {
     constexpr size_t num_thing_lists = 6;
+    // Loco code addresses things directly within its fixed array, so this cannot be raised
     constexpr size_t max_things = 20000;
 
     enum class thing_list
     {
         null,
         vehicle_head,
-        misc = 3,
+        vehicle,
+        misc,
+    };
+
+    struct ThingListStats
+    {
+        uint16_t count{};         // Things currently in the list
+        uint16_t highWaterMark{}; // Most things seen in the list at once, sampled on allocation through thingmgr
+        uint32_t allocations{};   // Things allocated into the list through thingmgr
+        uint32_t frees{};         // Things freed from the list through thingmgr
     };
 
     template<typename T>
@@ -34,6 +45,7 @@ namespace openloco::thingmgr
     T* first();
 
     thing_base* createThing();
+    vehicle_base* createVehicleThing();
     void freeThing(thing_base* const thing);
 
     void updateVehicles();
@@ -42,6 +54,15 @@ namespace openloco::thingmgr
     uint16_t getListCount(const thing_list list);
     void moveSpriteToList(thing_base* const thing, const thing_list list);
     bool checkNumFreeThings(const size_t numNewThings);
+    void releaseReservedThings();
+
+    ThingListStats getListStats(const thing_list list);
+    void resetListStats();
+
+    const std::vector<thing_id_t>& getCompanyVehicles(company_id_t owner, VehicleType type);
+    uint16_t getFreeVehicleNumber(company_id_t owner, VehicleType type);
+    void addToVehicleIndex(const vehicle_head* head);
+    void invalidateVehicleIndex();
 
     class VehicleHeadIterator
     {
@@ -1,6 +1,8 @@
 #include "vehicle.h"
+#include "../Benchmark.h"
 #include "../audio/audio.h"
 #include "../config.h"
+#include "../console.h"
 #include "../graphics/gfx.h"
 #include "../interop/interop.hpp"
 #include "../map/tilemgr.h"
@@ -12,7 +14,12 @@
 #include "misc.h"
 #include "thingmgr.h"
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+#include <vector>
 
 using namespace openloco;
 using namespace openloco::interop;
@@ -441,527 +448,230 @@ static uint16_t sub_4BE368(uint32_t distance)
     return vehicle_arr_500B50[distance >> 1] >> i;
 }
 
-// 0x004BF4DA
-uint8_t openloco::vehicle_body::updateSpritePitchSteepSlopes(uint16_t xy_offset, int16_t z_offset)
+// Sprite angles are picked by comparing the slope (a << 16) / b against the tangents of the angles half way
+// between neighbouring sprites. Comparing against the thresholds multiplied by b instead of dividing gives
+// the same result for any offset within the map.
+template<size_t N>
+static uint32_t countSlopeThresholds(uint16_t a, uint16_t b, const std::array<uint32_t, N>& thresholds)
 {
-    uint32_t i = 0;
-
-    if (z_offset < 0)
-    {
-        i = 5;
-        z_offset = -z_offset;
-    }
-
-    uint32_t xyz = std::numeric_limits<uint32_t>::max();
-    if (xy_offset != 0)
+    const uint64_t scaledA = static_cast<uint64_t>(a) << 16;
+    // Counting every threshold without branching is faster than a search as there are at most 16
+    uint32_t count = 0;
+    for (auto threshold : thresholds)
     {
-        xyz = static_cast<uint64_t>(z_offset << 16) / xy_offset;
+        count += scaledA >= static_cast<uint64_t>(threshold) * b;
     }
+    return count;
+}
 
-    if (xyz > 10064)
-    {
-        i += 2;
-        if (xyz >= 20500)
-        {
-            i++;
-            if (xyz >= 22000)
-            {
-                i++;
-            }
-        }
-    }
-    else
-    {
-        if (xyz >= 3331)
-        {
-            i++;
-        }
-    }
+// 0x004BF4DA
+uint8_t openloco::vehicle_body::updateSpritePitchSteepSlopes(uint16_t xy_offset, int16_t z_offset)
+{
+    constexpr std::array<uint32_t, 4> thresholds = { 3331, 10065, 20500, 22000 };
 
+    uint32_t i = z_offset < 0 ? 5 : 0;
+    i += countSlopeThresholds(static_cast<uint16_t>(std::abs(z_offset)), xy_offset, thresholds);
     return vehicleBodyIndexToPitch[i];
 }
 
 // 0x004BF49D
 uint8_t openloco::vehicle_body::updateSpritePitch(uint16_t xy_offset, int16_t z_offset)
 {
-    uint32_t i = 0;
+    constexpr std::array<uint32_t, 2> thresholds = { 3331, 9000 };
 
-    if (z_offset < 0)
-    {
-        i = 5;
-        z_offset = -z_offset;
-    }
+    uint32_t i = z_offset < 0 ? 5 : 0;
+    i += countSlopeThresholds(static_cast<uint16_t>(std::abs(z_offset)), xy_offset, thresholds);
+    return vehicleBodyIndexToPitch[i];
+}
 
-    uint32_t xyz = std::numeric_limits<uint32_t>::max();
-    if (xy_offset != 0)
+// Sprites of a body are spread evenly around the circle, N steps of 16 / N yaw per quadrant. Each quadrant
+// has N + 1 entries going from the y axis to the x axis, so the axes appear in two quadrants.
+template<size_t N>
+struct SpriteYawTable
+{
+    std::array<uint32_t, N> thresholds;
+    std::array<uint8_t, (N + 1) * 4> indexToYaw;
+
+    constexpr SpriteYawTable(const std::array<uint32_t, N>& slopeThresholds)
+        : thresholds(slopeThresholds)
+        , indexToYaw()
     {
-        xyz = static_cast<uint64_t>(z_offset << 16) / xy_offset;
+        constexpr uint8_t step = 16 / N;
+        for (size_t i = 0; i <= N; i++)
+        {
+            auto offset = static_cast<uint8_t>(i * step);
+            indexToYaw[i] = 16 + offset;
+            indexToYaw[(N + 1) + i] = 16 - offset;
+            indexToYaw[(N + 1) * 2 + i] = 48 - offset;
+            indexToYaw[(N + 1) * 3 + i] = (48 + offset) & 63;
+        }
     }
 
-    if (xyz >= 3331)
+    uint8_t getYaw(int16_t x_offset, int16_t y_offset) const
     {
-        i++;
-        if (xyz >= 9000)
+        uint32_t i = 0;
+        if (x_offset < 0)
         {
-            i++;
+            i += N + 1;
         }
+        if (y_offset < 0)
+        {
+            i += (N + 1) * 2;
+        }
+        i += countSlopeThresholds(static_cast<uint16_t>(std::abs(x_offset)), static_cast<uint16_t>(std::abs(y_offset)), thresholds);
+        return indexToYaw[i];
     }
+};
 
-    return vehicleBodyIndexToPitch[i];
-}
+// 0x00503E66
+static constexpr SpriteYawTable<1> spriteYaw0({ 65536 });
 
-// 0x004BF52B
-uint8_t openloco::vehicle_body::updateSpriteYaw0(int16_t x_offset, int16_t y_offset)
-{
-    uint32_t i = 0;
+// 0x00503E6E
+static constexpr SpriteYawTable<2> spriteYaw1({ 27146, 158218 });
 
-    if (x_offset < 0)
-    {
-        i += 2;
-        x_offset = -x_offset;
-    }
+// 0x00503E7A
+static constexpr SpriteYawTable<4> spriteYaw2({ 13036, 43790, 98082, 329472 });
 
-    if (y_offset < 0)
-    {
-        i += 4;
-        y_offset = -y_offset;
-    }
+// 0x00503E8E
+static constexpr SpriteYawTable<8> spriteYaw3({ 6455, 19880, 35030, 53784, 79856, 122609, 216043, 665398 });
 
-    uint32_t xy = std::numeric_limits<uint32_t>::max();
-    if (y_offset != 0)
-    {
-        xy = static_cast<uint64_t>(x_offset << 16) / y_offset;
-    }
+// 0x00503EB2
+static constexpr SpriteYawTable<16> spriteYaw4({ 3220, 9721, 16416, 23449, 30996, 39281, 48605, 59398, 72308, 88365, 109340, 138564, 183161, 261634, 441808, 1334016 });
 
-    if (xy >= 65536)
-    {
-        i++;
-    }
+static_assert(spriteYaw1.indexToYaw[4] == 8 && spriteYaw1.indexToYaw[10] == 56 && spriteYaw1.indexToYaw[11] == 0);
+static_assert(spriteYaw4.indexToYaw[33] == 0 && spriteYaw4.indexToYaw[50] == 32 && spriteYaw4.indexToYaw[67] == 0);
 
-    // 0x00503E66
-    constexpr uint8_t indexToYaw[] = {
-        16,
-        32,
-        16,
-        0,
-        48,
-        32,
-        48,
-        0
-    };
-    return indexToYaw[i];
+// 0x004BF52B
+uint8_t openloco::vehicle_body::updateSpriteYaw0(int16_t x_offset, int16_t y_offset)
+{
+    return spriteYaw0.getYaw(x_offset, y_offset);
 }
 
 // 0x004BF5B3
 uint8_t openloco::vehicle_body::updateSpriteYaw1(int16_t x_offset, int16_t y_offset)
 {
-    uint32_t i = 0;
-
-    if (x_offset < 0)
-    {
-        i += 3;
-        x_offset = -x_offset;
-    }
-
-    if (y_offset < 0)
-    {
-        i += 6;
-        y_offset = -y_offset;
-    }
-
-    uint32_t xy = std::numeric_limits<uint32_t>::max();
-    if (y_offset != 0)
-    {
-        xy = static_cast<uint64_t>(x_offset << 16) / y_offset;
-    }
-
-    if (xy >= 27146)
-    {
-        i++;
-        if (xy >= 158218)
-        {
-            i++;
-        }
-    }
-
-    // 0x00503E6E
-    constexpr uint8_t indexToYaw[] = {
-        16,
-        24,
-        32,
-        16,
-        8,
-        0,
-        48,
-        40,
-        32,
-        48,
-        56,
-        0
-    };
-    return indexToYaw[i];
+    return spriteYaw1.getYaw(x_offset, y_offset);
 }
 
 // 0x004BF5FB
 uint8_t openloco::vehicle_body::updateSpriteYaw2(int16_t x_offset, int16_t y_offset)
 {
-    uint32_t i = 0;
-
-    if (x_offset < 0)
-    {
-        i += 5;
-        x_offset = -x_offset;
-    }
-
-    if (y_offset < 0)
-    {
-        i += 10;
-        y_offset = -y_offset;
-    }
-
-    uint32_t xy = std::numeric_limits<uint32_t>::max();
-    if (y_offset != 0)
-    {
-        xy = static_cast<uint64_t>(x_offset << 16) / y_offset;
-    }
-
-    if (xy >= 43790)
-    {
-        i += 2;
-        if (xy >= 98082)
-        {
-            i++;
-            if (xy >= 329472)
-            {
-                i++;
-            }
-        }
-    }
-    else
-    {
-        if (xy >= 13036)
-        {
-            i++;
-        }
-    }
-
-    // 0x00503E7A
-    constexpr uint8_t indexToYaw[] = {
-        16,
-        20,
-        24,
-        28,
-        32,
-        16,
-        12,
-        8,
-        4,
-        0,
-        48,
-        44,
-        40,
-        36,
-        32,
-        48,
-        52,
-        56,
-        60,
-        0
-    };
-    return indexToYaw[i];
+    return spriteYaw2.getYaw(x_offset, y_offset);
 }
 
 // 0x004BF657
 uint8_t openloco::vehicle_body::updateSpriteYaw3(int16_t x_offset, int16_t y_offset)
 {
-    uint32_t i = 0;
-
-    if (x_offset < 0)
-    {
-        i += 9;
-        x_offset = -x_offset;
-    }
-
-    if (y_offset < 0)
-    {
-        i += 18;
-        y_offset = -y_offset;
-    }
+    return spriteYaw3.getYaw(x_offset, y_offset);
+}
 
-    uint32_t xy = std::numeric_limits<uint32_t>::max();
-    if (y_offset != 0)
-    {
-        xy = static_cast<uint64_t>(x_offset << 16) / y_offset;
-    }
+// 0x004BF6DF
+uint8_t openloco::vehicle_body::updateSpriteYaw4(int16_t x_offset, int16_t y_offset)
+{
+    return spriteYaw4.getYaw(x_offset, y_offset);
+}
 
-    if (xy >= 79856)
-    {
-        if (xy >= 216043)
-        {
-            i += 7;
-            if (xy >= 665398)
-            {
-                i++;
-            }
-        }
-        else
-        {
-            i += 5;
-            if (xy >= 122609)
-            {
-                i++;
-            }
-        }
-    }
-    else
+// The sprite angle lookups as they were before the threshold tables, dividing and then searching the thresholds.
+// Kept to check and time the tables against.
+static uint32_t countSlopeThresholdsByDivision(uint16_t a, uint16_t b, const uint32_t* thresholds, size_t numThresholds)
+{
+    uint32_t slope = std::numeric_limits<uint32_t>::max();
+    if (b != 0)
     {
-        if (xy >= 19880)
-        {
-            if (xy >= 35030)
-            {
-                i += 3;
-                if (xy >= 53784)
-                {
-                    i++;
-                }
-            }
-            else
-            {
-                i += 2;
-            }
-        }
-        else
-        {
-            if (xy >= 6455)
-            {
-                i++;
-            }
-        }
+        slope = static_cast<uint32_t>((static_cast<uint64_t>(a) << 16) / b);
     }
-
-    // 0x00503E8E
-    constexpr uint8_t indexToYaw[] = {
-        16,
-        18,
-        20,
-        22,
-        24,
-        26,
-        28,
-        30,
-        32,
-        16,
-        14,
-        12,
-        10,
-        8,
-        6,
-        4,
-        2,
-        0,
-        48,
-        46,
-        44,
-        42,
-        40,
-        38,
-        36,
-        34,
-        32,
-        48,
-        50,
-        52,
-        54,
-        56,
-        58,
-        60,
-        62,
-        0
-    };
-    return indexToYaw[i];
+    return static_cast<uint32_t>(std::upper_bound(thresholds, thresholds + numThresholds, slope) - thresholds);
 }
 
-// 0x004BF6DF
-uint8_t openloco::vehicle_body::updateSpriteYaw4(int16_t x_offset, int16_t y_offset)
+template<size_t N>
+static uint8_t getYawByDivision(const uint8_t* indexToYaw, const uint32_t (&thresholds)[N], int16_t x_offset, int16_t y_offset)
 {
     uint32_t i = 0;
-
     if (x_offset < 0)
     {
-        i += 17;
-        x_offset = -x_offset;
+        i += N + 1;
     }
-
     if (y_offset < 0)
     {
-        i += 34;
-        y_offset = -y_offset;
+        i += (N + 1) * 2;
     }
+    i += countSlopeThresholdsByDivision(static_cast<uint16_t>(std::abs(x_offset)), static_cast<uint16_t>(std::abs(y_offset)), thresholds, N);
+    return indexToYaw[i];
+}
 
-    uint32_t xy = std::numeric_limits<uint32_t>::max();
-    if (y_offset != 0)
-    {
-        xy = static_cast<uint64_t>(x_offset << 16) / y_offset;
-    }
+// Checks the yaw tables against loco's index to yaw tables with the thresholds of the original compare trees,
+// and the pitch thresholds against the original compare trees, over every offset within 600 of the origin
+// and over random offsets within the map. Then times the lookups both ways.
+bool openloco::things::vehicle::benchmarkSpriteAngles()
+{
+    static loco_global<uint8_t[8], 0x00503E66> spriteYaw0IndexToYaw;
+    static loco_global<uint8_t[12], 0x00503E6E> spriteYaw1IndexToYaw;
+    static loco_global<uint8_t[20], 0x00503E7A> spriteYaw2IndexToYaw;
+    static loco_global<uint8_t[36], 0x00503E8E> spriteYaw3IndexToYaw;
+    static loco_global<uint8_t[68], 0x00503EB2> spriteYaw4IndexToYaw;
+    constexpr uint32_t yaw0Thresholds[] = { 65536 };
+    constexpr uint32_t yaw1Thresholds[] = { 27146, 158218 };
+    constexpr uint32_t yaw2Thresholds[] = { 13036, 43790, 98082, 329472 };
+    constexpr uint32_t yaw3Thresholds[] = { 6455, 19880, 35030, 53784, 79856, 122609, 216043, 665398 };
+    constexpr uint32_t yaw4Thresholds[] = { 3220, 9721, 16416, 23449, 30996, 39281, 48605, 59398, 72308, 88365, 109340, 138564, 183161, 261634, 441808, 1334016 };
+    constexpr uint32_t pitchThresholds[] = { 3331, 9000 };
+    constexpr uint32_t steepPitchThresholds[] = { 3331, 10065, 20500, 22000 };
+    constexpr std::array<uint32_t, 2> pitchTable = { 3331, 9000 };
+    constexpr std::array<uint32_t, 4> steepPitchTable = { 3331, 10065, 20500, 22000 };
+
+    uint32_t mismatches = 0;
+    auto check = [&](int16_t x, int16_t y) {
+        mismatches += spriteYaw0.getYaw(x, y) != getYawByDivision(spriteYaw0IndexToYaw.get(), yaw0Thresholds, x, y);
+        mismatches += spriteYaw1.getYaw(x, y) != getYawByDivision(spriteYaw1IndexToYaw.get(), yaw1Thresholds, x, y);
+        mismatches += spriteYaw2.getYaw(x, y) != getYawByDivision(spriteYaw2IndexToYaw.get(), yaw2Thresholds, x, y);
+        mismatches += spriteYaw3.getYaw(x, y) != getYawByDivision(spriteYaw3IndexToYaw.get(), yaw3Thresholds, x, y);
+        mismatches += spriteYaw4.getYaw(x, y) != getYawByDivision(spriteYaw4IndexToYaw.get(), yaw4Thresholds, x, y);
+
+        auto xy = static_cast<uint16_t>(std::abs(x));
+        auto z = static_cast<uint16_t>(std::abs(y));
+        mismatches += countSlopeThresholds(z, xy, pitchTable) != countSlopeThresholdsByDivision(z, xy, pitchThresholds, std::size(pitchThresholds));
+        mismatches += countSlopeThresholds(z, xy, steepPitchTable) != countSlopeThresholdsByDivision(z, xy, steepPitchThresholds, std::size(steepPitchThresholds));
+    };
 
-    if (xy >= 72308)
-    {
-        if (xy >= 183161)
-        {
-            if (xy >= 441808)
-            {
-                i += 15;
-                if (xy >= 1334016)
-                {
-                    i++;
-                }
-            }
-            else
-            {
-                i += 13;
-                if (xy >= 261634)
-                {
-                    i++;
-                }
-            }
-        }
-        else
-        {
-            if (xy >= 109340)
-            {
-                i += 11;
-                if (xy >= 138564)
-                {
-                    i++;
-                }
-            }
-            else
-            {
-                i += 9;
-                if (xy >= 88365)
-                {
-                    i++;
-                }
-            }
-        }
-    }
-    else
+    for (int16_t y = -600; y <= 600; y++)
     {
-        if (xy >= 23449)
-        {
-            if (xy >= 39281)
-            {
-                i += 6;
-                if (xy >= 48605)
-                {
-                    i++;
-                    if (xy >= 59398)
-                    {
-                        i++;
-                    }
-                }
-            }
-            else
-            {
-                i += 4;
-                if (xy >= 30996)
-                {
-                    i++;
-                }
-            }
-        }
-        else
+        for (int16_t x = -600; x <= 600; x++)
         {
-            if (xy >= 9721)
-            {
-                i += 2;
-                if (xy >= 16416)
-                {
-                    i++;
-                }
-            }
-            else
-            {
-                if (xy >= 3220)
-                {
-                    i++;
-                }
-            }
+            check(x, y);
         }
     }
 
-    // 0x00503EB2
-    constexpr uint8_t indexToYaw[] = {
-        16,
-        17,
-        18,
-        19,
-        20,
-        21,
-        22,
-        23,
-        24,
-        25,
-        26,
-        27,
-        28,
-        29,
-        30,
-        31,
-        32,
-        16,
-        15,
-        14,
-        13,
-        12,
-        11,
-        10,
-        9,
-        8,
-        7,
-        6,
-        5,
-        4,
-        3,
-        2,
-        1,
-        0,
-        48,
-        47,
-        46,
-        45,
-        44,
-        43,
-        42,
-        41,
-        40,
-        39,
-        38,
-        37,
-        36,
-        35,
-        34,
-        33,
-        32,
-        48,
-        49,
-        50,
-        51,
-        52,
-        53,
-        54,
-        55,
-        56,
-        57,
-        58,
-        59,
-        60,
-        61,
-        62,
-        63,
-        0
-    };
-    return indexToYaw[i];
+    // Offsets between bogies anywhere on the map, from a fixed seed so that every run times the same offsets
+    constexpr size_t numOffsets = 1 << 20;
+    std::vector<std::pair<int16_t, int16_t>> offsets(numOffsets);
+    uint32_t seed = 0x12345678;
+    for (auto& [x, y] : offsets)
+    {
+        seed = seed * 1664525 + 1013904223;
+        x = static_cast<int16_t>(static_cast<int32_t>(seed >> 16) % 12288 - 6144) * 2;
+        seed = seed * 1664525 + 1013904223;
+        y = static_cast<int16_t>(static_cast<int32_t>(seed >> 16) % 12288 - 6144) * 2;
+        check(x, y);
+    }
+    if (mismatches != 0)
+    {
+        console::error("  %u lookups differ", mismatches);
+    }
+
+    volatile uint32_t sink = 0;
+    benchmark::measure("yaw4, by division", numOffsets, [&](uint32_t i) {
+        sink = sink + getYawByDivision(spriteYaw4IndexToYaw.get(), yaw4Thresholds, offsets[i].first, offsets[i].second);
+    });
+    benchmark::measure("yaw4, threshold table", numOffsets, [&](uint32_t i) {
+        sink = sink + spriteYaw4.getYaw(offsets[i].first, offsets[i].second);
+    });
+    benchmark::measure("steep pitch, by division", numOffsets, [&](uint32_t i) {
+        sink = sink + countSlopeThresholdsByDivision(static_cast<uint16_t>(std::abs(offsets[i].second)), static_cast<uint16_t>(std::abs(offsets[i].first)), steepPitchThresholds, std::size(steepPitchThresholds));
+    });
+    benchmark::measure("steep pitch, threshold table", numOffsets, [&](uint32_t i) {
+        sink = sink + countSlopeThresholds(static_cast<uint16_t>(std::abs(offsets[i].second)), static_cast<uint16_t>(std::abs(offsets[i].first)), steepPitchTable);
+    });
+    return mismatches == 0;
 }
 
 // 0x004AB655
@@ -676,5 +676,7 @@ namespace openloco
             }
             Vehicle(uint16_t _head);
         };
+
+        bool benchmarkSpriteAngles();
     }
 }
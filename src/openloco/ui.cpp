@@ -335,11 +335,6 @@ namespace openloco::ui
         width = (int32_t)(width / scale_factor);
         height = (int32_t)(height / scale_factor);
 
-        int32_t widthShift = 6;
-        int16_t blockWidth = 1 << widthShift;
-        int32_t heightShift = 3;
-        int16_t blockHeight = 1 << heightShift;
-
         if (surface != nullptr)
         {
             SDL_FreeSurface(surface);
@@ -371,13 +366,9 @@ namespace openloco::ui
         screen_info->height_2 = height;
         screen_info->width_3 = width;
         screen_info->height_3 = height;
-        screen_info->dirty_block_width = blockWidth;
-        screen_info->dirty_block_height = blockHeight;
-        screen_info->dirty_block_columns = (width / blockWidth) + 1;
-        screen_info->dirty_block_rows = (height / blockHeight) + 1;
-        screen_info->dirty_block_column_shift = widthShift;
-        screen_info->dirty_block_row_shift = heightShift;
-        screen_info->dirty_blocks_initialised = 1;
+
+        const auto& displayConfig = config::get_new().display;
+        gfx::resize_dirty_blocks(width, height, displayConfig.dirty_block_width_shift, displayConfig.dirty_block_height_shift);
     }
 
     static void position_changed(int32_t x, int32_t y)
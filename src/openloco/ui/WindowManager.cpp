@@ -11,6 +11,7 @@
 #include "../map/tile.h"
 #include "../map/tilemgr.h"
 #include "../multiplayer.h"
+#include "../openloco.h"
 #include "../stationmgr.h"
 #include "../things/thingmgr.h"
 #include "../things/vehicle.h"
@@ -275,6 +276,16 @@ namespace openloco::ui::WindowManager
                 return 0;
             });
 
+        register_hook(
+            0x004C5CFA,
+            [](registers& regs) FORCE_ALIGN_ARG_POINTER -> uint8_t {
+                registers backup = regs;
+                gfx::draw_dirty_blocks();
+                regs = backup;
+
+                return 0;
+            });
+
         register_hook(
             0x004C9984,
             [](registers& regs) FORCE_ALIGN_ARG_POINTER -> uint8_t {
@@ -538,7 +549,8 @@ namespace openloco::ui::WindowManager
             return;
         }
 
-        if (!intro::is_active())
+        // Dirty blocks accumulate until the next presented frame while fast-forwarding
+        if (!intro::is_active() && isPresentingFrame())
         {
             gfx::draw_dirty_blocks();
         }
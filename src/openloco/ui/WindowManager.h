@@ -317,6 +317,11 @@ namespace openloco::ui::TimePanel
     window* open();
 }
 
+namespace openloco::ui::windows::TickProfiler
+{
+    void toggle();
+}
+
 namespace openloco::ui::windows::toolbar_bottom::editor
 {
     void open();
@@ -63,6 +63,7 @@ namespace openloco::ui
         confirmationPrompt = 54,
         openLocoVersion = 55,
         titleOptions = 56,
+        tickProfiler = 57,
 
         undefined = 255
     };
@@ -0,0 +1,116 @@
+#include "hash.hpp"
+#include "numeric.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace openloco::utility
+{
+    static constexpr uint32_t prime1 = 2654435761U;
+    static constexpr uint32_t prime2 = 2246822519U;
+    static constexpr uint32_t prime3 = 3266489917U;
+    static constexpr uint32_t prime4 = 668265263U;
+    static constexpr uint32_t prime5 = 374761393U;
+
+    static uint32_t read32(const uint8_t* data)
+    {
+        uint32_t value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    static uint32_t round(uint32_t lane, uint32_t input)
+    {
+        lane += input * prime2;
+        lane = rol(lane, 13);
+        return lane * prime1;
+    }
+
+    XxHash32::XxHash32(uint32_t seed)
+        : _seed(seed)
+        , _lanes{ seed + prime1 + prime2, seed + prime2, seed, seed - prime1 }
+    {
+    }
+
+    void XxHash32::consumeStripes(const uint8_t* data, size_t count)
+    {
+        uint32_t lanes[4] = { _lanes[0], _lanes[1], _lanes[2], _lanes[3] };
+        for (size_t i = 0; i < count; i++, data += stripeSize)
+        {
+            for (size_t lane = 0; lane < 4; lane++)
+            {
+                lanes[lane] = round(lanes[lane], read32(data + lane * 4));
+            }
+        }
+        std::memcpy(_lanes, lanes, sizeof(lanes));
+    }
+
+    void XxHash32::update(const void* data, size_t length)
+    {
+        auto input = static_cast<const uint8_t*>(data);
+        _length += length;
+
+        // Complete a stripe left over from the previous update
+        if (_bufferSize != 0)
+        {
+            auto fill = std::min(stripeSize - _bufferSize, length);
+            std::memcpy(_buffer + _bufferSize, input, fill);
+            _bufferSize += fill;
+            input += fill;
+            length -= fill;
+            if (_bufferSize < stripeSize)
+            {
+                return;
+            }
+            consumeStripes(_buffer, 1);
+            _bufferSize = 0;
+        }
+
+        auto stripes = length / stripeSize;
+        consumeStripes(input, stripes);
+        input += stripes * stripeSize;
+        length -= stripes * stripeSize;
+
+        std::memcpy(_buffer, input, length);
+        _bufferSize = length;
+    }
+
+    uint32_t XxHash32::digest() const
+    {
+        uint32_t hash;
+        if (_length >= stripeSize)
+        {
+            hash = rol(_lanes[0], 1) + rol(_lanes[1], 7) + rol(_lanes[2], 12) + rol(_lanes[3], 18);
+        }
+        else
+        {
+            hash = _seed + prime5;
+        }
+        hash += static_cast<uint32_t>(_length);
+
+        size_t i = 0;
+        for (; i + 4 <= _bufferSize; i += 4)
+        {
+            hash += read32(_buffer + i) * prime3;
+            hash = rol(hash, 17) * prime4;
+        }
+        for (; i < _bufferSize; i++)
+        {
+            hash += _buffer[i] * prime5;
+            hash = rol(hash, 11) * prime1;
+        }
+
+        hash ^= hash >> 15;
+        hash *= prime2;
+        hash ^= hash >> 13;
+        hash *= prime3;
+        hash ^= hash >> 16;
+        return hash;
+    }
+
+    uint32_t xxHash32(const void* data, size_t length, uint32_t seed)
+    {
+        XxHash32 hash(seed);
+        hash.update(data, length);
+        return hash.digest();
+    }
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace openloco::utility
+{
+    // Streaming xxHash32. Input is consumed as four independent 32-bit lanes which
+    // compilers can keep in a single SIMD register.
+    class XxHash32
+    {
+    private:
+        static constexpr size_t stripeSize = 16;
+
+        uint32_t _seed;
+        uint32_t _lanes[4];
+        uint8_t _buffer[stripeSize];
+        size_t _bufferSize = 0;
+        uint64_t _length = 0;
+
+    public:
+        explicit XxHash32(uint32_t seed = 0);
+
+        void update(const void* data, size_t length);
+        uint32_t digest() const;
+
+    private:
+        void consumeStripes(const uint8_t* data, size_t count);
+    };
+
+    uint32_t xxHash32(const void* data, size_t length, uint32_t seed = 0);
+}
@@ -32,6 +32,19 @@ namespace openloco::utility
 #endif
     }
 
+    // Finds the first bit set in a 64-bits numeral and returns its index, or -1 if no bit is set.
+    int32_t bitScanForward64(uint64_t source)
+    {
+        auto low = static_cast<uint32_t>(source);
+        if (low != 0)
+        {
+            return bitScanForward(low);
+        }
+
+        auto high = bitScanForward(static_cast<uint32_t>(source >> 32));
+        return high != -1 ? high + 32 : -1;
+    }
+
     int32_t bitScanReverse(uint32_t source)
     {
 #if defined(_MSC_VER) && (_MSC_VER >= 1400) // Visual Studio 2005
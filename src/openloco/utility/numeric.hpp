@@ -8,6 +8,7 @@
 namespace openloco::utility
 {
     int32_t bitScanForward(uint32_t source);
+    int32_t bitScanForward64(uint64_t source);
 
     int32_t bitScanReverse(uint32_t source);
 
@@ -22,6 +22,16 @@ namespace openloco::ui::viewportmgr
 
     static loco_global<int32_t, 0x00E3F0B8> currentRotation;
 
+    struct PendingInvalidation
+    {
+        ViewportRect rect;
+        ZoomLevel zoom;
+    };
+
+    // Things invalidated while batching, each merged into the previous one when they overlap
+    static std::vector<PendingInvalidation> _pendingInvalidations;
+    static bool _isBatchingInvalidations;
+
     static viewport* create(registers regs, int index);
 
     void init()
@@ -291,6 +301,42 @@ namespace openloco::ui::viewportmgr
         }
     }
 
+    static void addPendingInvalidation(const ViewportRect& rect, ZoomLevel zoom)
+    {
+        if (!_pendingInvalidations.empty())
+        {
+            auto& last = _pendingInvalidations.back();
+            if (last.zoom == zoom
+                && rect.left <= last.rect.right && last.rect.left <= rect.right
+                && rect.top <= last.rect.bottom && last.rect.top <= rect.bottom)
+            {
+                last.rect.left = std::min(last.rect.left, rect.left);
+                last.rect.top = std::min(last.rect.top, rect.top);
+                last.rect.right = std::max(last.rect.right, rect.right);
+                last.rect.bottom = std::max(last.rect.bottom, rect.bottom);
+                return;
+            }
+        }
+        _pendingInvalidations.push_back({ rect, zoom });
+    }
+
+    // Defers the invalidation of things until endBatchedInvalidation. A thing is usually invalidated
+    // both before and after it moves, which then costs a single pass over the viewports.
+    void beginBatchedInvalidation()
+    {
+        _isBatchingInvalidations = true;
+    }
+
+    void endBatchedInvalidation()
+    {
+        _isBatchingInvalidations = false;
+        for (const auto& pending : _pendingInvalidations)
+        {
+            invalidate(pending.rect, pending.zoom);
+        }
+        _pendingInvalidations.clear();
+    }
+
     /**
      * 0x004CBB01 (eight)
      * 0x004CBBD2 (quarter)
@@ -312,6 +358,11 @@ namespace openloco::ui::viewportmgr
         rect.bottom = t->sprite_bottom;
 
         auto level = (ZoomLevel)std::min(config::get().vehicles_min_scale, (uint8_t)zoom);
+        if (_isBatchingInvalidations)
+        {
+            addPendingInvalidation(rect, level);
+            return;
+        }
         invalidate(rect, level);
     }
 
@@ -19,4 +19,6 @@ namespace openloco::ui::viewportmgr
     void invalidate(station* station);
     void invalidate(Thing* t, ZoomLevel zoom);
     void invalidate(map::map_pos pos, coord_t zMin, coord_t zMax, ZoomLevel zoom = ZoomLevel::eighth, int radius = 32);
+    void beginBatchedInvalidation();
+    void endBatchedInvalidation();
 }
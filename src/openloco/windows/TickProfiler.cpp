@@ -0,0 +1,136 @@
+#include "../TickProfiler.h"
+#include "../graphics/colours.h"
+#include "../graphics/gfx.h"
+#include "../localisation/FormatArguments.hpp"
+#include "../localisation/string_ids.h"
+#include "../localisation/stringmgr.h"
+#include "../openloco.h"
+#include "../ui.h"
+#include "../ui/WindowManager.h"
+#include "../window.h"
+#include <cstdio>
+
+namespace openloco::ui::windows::TickProfiler
+{
+    using tickprofiler::Stage;
+
+    static constexpr int16_t lineHeight = 10;
+    static constexpr int16_t columnWidth = 50;
+    static constexpr int16_t nameWidth = 90;
+    // Heading, one line per stage, the frame line and the recording status
+    static constexpr int16_t numLines = tickprofiler::stageCount + 3;
+    static const gfx::ui_size_t windowSize = { nameWidth + columnWidth * 4, numLines * lineHeight };
+
+    // Number of window updates between refreshes of the figures
+    static constexpr uint16_t refreshInterval = 20;
+
+    static widget_t _widgets[] = {
+        widget_end(),
+    };
+
+    static window_event_list _events;
+
+    static void onUpdate(window* w);
+    static void draw(ui::window* w, gfx::drawpixelinfo_t* dpi);
+
+    // Shows the rolling timings of each tick_logic stage and of whole frames in the top left corner, or closes it when already open.
+    void toggle()
+    {
+        if (WindowManager::find(WindowType::tickProfiler) != nullptr)
+        {
+            WindowManager::close(WindowType::tickProfiler);
+            return;
+        }
+
+        _events.on_update = onUpdate;
+        _events.draw = draw;
+
+        auto window = WindowManager::createWindow(
+            WindowType::tickProfiler,
+            gfx::point_t(8, 32),
+            windowSize,
+            window_flags::stick_to_front | window_flags::transparent | window_flags::no_background,
+            &_events);
+        window->widgets = _widgets;
+        window->var_854 = 0;
+    }
+
+    static void onUpdate(window* w)
+    {
+        w->var_854++;
+        if (w->var_854 >= refreshInterval)
+        {
+            w->var_854 = 0;
+            w->invalidate();
+        }
+    }
+
+    static void drawString(gfx::drawpixelinfo_t* dpi, int16_t x, int16_t y, string_id stringId, const char* text = nullptr)
+    {
+        FormatArguments args{};
+        args.push(text);
+        gfx::draw_string_494B3F(*dpi, x, y, colour::white | format_flags::textflag_5, stringId, &args);
+    }
+
+    static void drawHeader(gfx::drawpixelinfo_t* dpi, int16_t x, int16_t y)
+    {
+        static constexpr string_id columns[] = {
+            string_ids::tick_profiler_average,
+            string_ids::tick_profiler_minimum,
+            string_ids::tick_profiler_maximum,
+            string_ids::tick_profiler_p99,
+        };
+
+        drawString(dpi, x, y, string_ids::tick_profiler_stage_ms);
+        for (int16_t i = 0; i < 4; i++)
+        {
+            drawString(dpi, x + nameWidth + i * columnWidth, y, columns[i]);
+        }
+    }
+
+    static void drawLine(gfx::drawpixelinfo_t* dpi, int16_t x, int16_t y, const char* name, const char* const (&columns)[4])
+    {
+        drawString(dpi, x, y, string_ids::stringptr, name);
+        for (int16_t i = 0; i < 4; i++)
+        {
+            drawString(dpi, x + nameWidth + i * columnWidth, y, string_ids::stringptr, columns[i]);
+        }
+    }
+
+    static void drawTimings(gfx::drawpixelinfo_t* dpi, int16_t x, int16_t y, const char* name, double averageMs, double minMs, double maxMs, double p99Ms)
+    {
+        char buffers[4][16];
+        std::snprintf(buffers[0], sizeof(buffers[0]), "%.3f", averageMs);
+        std::snprintf(buffers[1], sizeof(buffers[1]), "%.3f", minMs);
+        std::snprintf(buffers[2], sizeof(buffers[2]), "%.3f", maxMs);
+        std::snprintf(buffers[3], sizeof(buffers[3]), "%.3f", p99Ms);
+        drawLine(dpi, x, y, name, { buffers[0], buffers[1], buffers[2], buffers[3] });
+    }
+
+    static void draw(ui::window* w, gfx::drawpixelinfo_t* dpi)
+    {
+        int16_t y = w->y;
+        drawHeader(dpi, w->x, y);
+        y += lineHeight;
+
+        for (size_t i = 0; i < tickprofiler::stageCount; i++)
+        {
+            auto stage = static_cast<Stage>(i);
+            auto stats = tickprofiler::getStats(stage);
+
+            drawTimings(dpi, w->x, y, tickprofiler::getStageName(stage), stats.averageMs, stats.minMs, stats.maxMs, stats.p99Ms);
+            y += lineHeight;
+        }
+
+        // Work time of whole frames, including drawing, excluding the time spent waiting for the next frame
+        auto frameStats = getFrameStats();
+        drawTimings(dpi, w->x, y, "frame", frameStats.averageMs, frameStats.minMs, frameStats.maxMs, frameStats.p99Ms);
+        y += lineHeight;
+
+        if (tickprofiler::isRecordingCsv())
+        {
+            auto path = tickprofiler::getCsvPath().u8string();
+            drawString(dpi, w->x, y, string_ids::tick_profiler_recording, path.c_str());
+        }
+    }
+}
@@ -34,6 +34,7 @@ namespace openloco::ui::TimePanel
             normal_speed_btn,
             fast_forward_btn,
             extra_fast_forward_btn,
+            fast_forward_menu,
         };
     }
 
@@ -41,6 +42,8 @@ namespace openloco::ui::TimePanel
     static void processChatMessage(char* str);
     static void togglePaused();
     static void changeGameSpeed(window* w, uint8_t speed);
+    static void fastForwardMouseDown(window* w, widget_index widgetIndex);
+    static void fastForwardDropdown(window* w, int16_t itemIndex);
 
     static widget_t _widgets[] = {
         make_widget({ 0, 0 }, { 140, 29 }, widget_type::wt_3, 0),                                                                                           // 0,
@@ -51,6 +54,7 @@ namespace openloco::ui::TimePanel
         make_remap_widget({ 38, 15 }, { 20, 12 }, widget_type::wt_9, 0, image_ids::speed_normal, string_ids::tooltip_speed_normal),                         // 5,
         make_remap_widget({ 58, 15 }, { 20, 12 }, widget_type::wt_9, 0, image_ids::speed_fast_forward, string_ids::tooltip_speed_fast_forward),             // 6,
         make_remap_widget({ 78, 15 }, { 20, 12 }, widget_type::wt_9, 0, image_ids::speed_extra_fast_forward, string_ids::tooltip_speed_extra_fast_forward), // 7,
+        make_widget({ 98, 15 }, { 13, 12 }, widget_type::wt_11, 0, string_ids::dropdown, string_ids::tooltip_speed_native_fast_forward),                    // 8,
         widget_end(),
     };
 
@@ -98,7 +102,7 @@ namespace openloco::ui::TimePanel
             ui::window_flags::stick_to_front | ui::window_flags::transparent | ui::window_flags::no_background,
             &_events);
         window->widgets = _widgets;
-        window->enabled_widgets = (1 << widx::map_chat_menu) | (1 << widx::date_btn) | (1 << widx::pause_btn) | (1 << widx::normal_speed_btn) | (1 << widx::fast_forward_btn) | (1 << widx::extra_fast_forward_btn);
+        window->enabled_widgets = (1 << widx::map_chat_menu) | (1 << widx::date_btn) | (1 << widx::pause_btn) | (1 << widx::normal_speed_btn) | (1 << widx::fast_forward_btn) | (1 << widx::extra_fast_forward_btn) | (1 << widx::fast_forward_menu);
         window->var_854 = 0;
         window->var_856 = 0;
         window->init_scroll_widgets();
@@ -143,6 +147,7 @@ namespace openloco::ui::TimePanel
         {
             _widgets[widx::fast_forward_btn].type = widget_type::none;
             _widgets[widx::extra_fast_forward_btn].type = widget_type::none;
+            _widgets[widx::fast_forward_menu].type = widget_type::none;
 
             _widgets[widx::pause_btn].left = 38;
             _widgets[widx::pause_btn].right = 57;
@@ -153,6 +158,7 @@ namespace openloco::ui::TimePanel
         {
             _widgets[widx::fast_forward_btn].type = widget_type::wt_9;
             _widgets[widx::extra_fast_forward_btn].type = widget_type::wt_9;
+            _widgets[widx::fast_forward_menu].type = widget_type::wt_11;
 
             _widgets[widx::pause_btn].left = 18;
             _widgets[widx::pause_btn].right = 37;
@@ -290,6 +296,9 @@ namespace openloco::ui::TimePanel
             case widx::map_chat_menu:
                 mapMouseDown(window, widgetIndex);
                 break;
+            case widx::fast_forward_menu:
+                fastForwardMouseDown(window, widgetIndex);
+                break;
         }
     }
 
@@ -301,6 +310,9 @@ namespace openloco::ui::TimePanel
             case widx::map_chat_menu:
                 mapDropdown(w, widgetIndex, item_index);
                 break;
+            case widx::fast_forward_menu:
+                fastForwardDropdown(w, item_index);
+                break;
         }
     }
 
@@ -409,6 +421,30 @@ namespace openloco::ui::TimePanel
         w->invalidate();
     }
 
+    static void fastForwardMouseDown(window* w, widget_index widgetIndex)
+    {
+        dropdown::add(0, string_ids::dropdown_stringid, string_ids::native_fast_forward_off);
+        dropdown::add(1, string_ids::dropdown_stringid, string_ids::native_fast_forward_x4);
+        dropdown::add(2, string_ids::dropdown_stringid, string_ids::native_fast_forward_x16);
+        dropdown::add(3, string_ids::dropdown_stringid, string_ids::native_fast_forward_max);
+        dropdown::showBelow(w, widgetIndex, 4, 0);
+        dropdown::setItemSelected(static_cast<size_t>(getFastForward()));
+    }
+
+    static void fastForwardDropdown(window* w, int16_t itemIndex)
+    {
+        if (itemIndex == -1)
+            return;
+
+        if (get_pause_flags() & 1)
+        {
+            game_commands::do_20();
+        }
+
+        setFastForward(static_cast<FastForward>(itemIndex));
+        w->invalidate();
+    }
+
     // 0x00439AD9
     static void onUpdate(window* w)
     {
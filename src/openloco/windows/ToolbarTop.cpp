@@ -119,10 +119,18 @@ namespace openloco::ui::windows::toolbar_top::game
         dropdown::add(3, string_ids::menu_about);
         dropdown::add(4, string_ids::options);
         dropdown::add(5, string_ids::menu_screenshot);
-        dropdown::add(6, 0);
-        dropdown::add(7, string_ids::menu_quit_to_menu);
-        dropdown::add(8, string_ids::menu_exit_openloco);
-        dropdown::showBelow(window, widgetIndex, 9, 0);
+        dropdown::add(6, string_ids::menu_tick_profiler);
+        dropdown::add(7, 0);
+        dropdown::add(8, string_ids::menu_quit_to_menu);
+        dropdown::add(9, string_ids::menu_exit_openloco);
+        size_t count = 10;
+        if (interop::is_call_profile_enabled())
+        {
+            dropdown::add(10, 0);
+            dropdown::add(11, string_ids::menu_print_reset_interop_call_profile);
+            count = 12;
+        }
+        dropdown::showBelow(window, widgetIndex, count, 0);
         dropdown::setHighlightedItem(1);
     }
 
@@ -159,15 +167,25 @@ namespace openloco::ui::windows::toolbar_top::game
                 break;
             }
 
-            case 7:
+            case 6:
+                TickProfiler::toggle();
+                break;
+
+            case 8:
                 // Return to title screen
                 game_commands::do_21(0, 1);
                 break;
 
-            case 8:
+            case 9:
                 // Exit to desktop
                 game_commands::do_21(0, 2);
                 break;
+
+            case 11:
+                // Each print covers the calls made since the previous one
+                interop::print_call_profile();
+                interop::reset_call_profile();
+                break;
         }
     }
 
@@ -405,15 +423,16 @@ namespace openloco::ui::windows::toolbar_top::game
         auto interface = objectmgr::get<interface_skin_object>();
 
         uint16_t vehicle_counts[vehicleTypeCount]{ 0 };
-        for (auto v : thingmgr::VehicleList())
+        for (uint8_t vehicleType = 0; vehicleType < vehicleTypeCount; vehicleType++)
         {
-            if (v->owner != player_company_id)
-                continue;
-
-            if ((v->var_38 & things::vehicle::flags_38::unk_4) != 0)
-                continue;
+            for (auto id : thingmgr::getCompanyVehicles(player_company_id, static_cast<VehicleType>(vehicleType)))
+            {
+                auto v = thingmgr::get<vehicle_head>(id);
+                if ((v->var_38 & things::vehicle::flags_38::unk_4) != 0)
+                    continue;
 
-            vehicle_counts[static_cast<uint8_t>(v->vehicleType)]++;
+                vehicle_counts[vehicleType]++;
+            }
         }
 
         uint8_t ddIndex = 0;